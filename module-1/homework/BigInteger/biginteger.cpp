@@ -0,0 +1,600 @@
+#include "biginteger.h"
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+using limb_type = BigInteger::limb_type;
+using wide_type = BigInteger::wide_type;
+using limbs_type = BigInteger::limbs_type;
+
+constexpr int kLimbBits = 32;
+constexpr wide_type kLimbMask = 0xffffffffull;
+
+// Below this many limbs in the shorter factor Karatsuba loses to the schoolbook loop
+constexpr size_t kKaratsubaThreshold = 32;
+
+// Decimal conversion works in chunks of nine digits, the largest power of ten in a limb
+constexpr limb_type kDecimalChunk = 1000000000;
+constexpr size_t kDecimalChunkDigits = 9;
+
+void Trim(limbs_type* limbs) {
+    while (!limbs->empty() && limbs->back() == 0) {
+        limbs->pop_back();
+    }
+}
+
+int CompareMagnitude(const limbs_type& lhs, const limbs_type& rhs) {
+    if (lhs.size() != rhs.size()) {
+        return lhs.size() < rhs.size() ? -1 : 1;
+    }
+    for (size_t i = lhs.size(); i > 0; --i) {
+        if (lhs[i - 1] != rhs[i - 1]) {
+            return lhs[i - 1] < rhs[i - 1] ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+// Multiplication
+
+// out[shift...] += value, out must be long enough to take the carry
+void AddShifted(limbs_type* out, const limbs_type& value, size_t shift) {
+    wide_type carry = 0;
+    size_t i = 0;
+    for (; i < value.size(); ++i) {
+        carry += static_cast<wide_type>((*out)[i + shift]) + value[i];
+        (*out)[i + shift] = static_cast<limb_type>(carry);
+        carry >>= kLimbBits;
+    }
+    for (; carry != 0; ++i) {
+        carry += (*out)[i + shift];
+        (*out)[i + shift] = static_cast<limb_type>(carry);
+        carry >>= kLimbBits;
+    }
+}
+
+// out -= value, for out >= value
+void SubtractFrom(limbs_type* out, const limbs_type& value) {
+    limb_type borrow = 0;
+    size_t i = 0;
+    for (; i < value.size(); ++i) {
+        wide_type subtrahend = static_cast<wide_type>(value[i]) + borrow;
+        borrow = (*out)[i] < subtrahend ? 1 : 0;
+        (*out)[i] = static_cast<limb_type>((*out)[i] - subtrahend);
+    }
+    for (; borrow != 0; ++i) {
+        borrow = (*out)[i] == 0 ? 1 : 0;
+        --(*out)[i];
+    }
+}
+
+limbs_type Sum(const limb_type* a, size_t a_size, const limb_type* b, size_t b_size) {
+    if (a_size < b_size) {
+        return Sum(b, b_size, a, a_size);
+    }
+
+    limbs_type result(a_size + 1);
+    wide_type carry = 0;
+    for (size_t i = 0; i < a_size; ++i) {
+        carry += static_cast<wide_type>(a[i]) + (i < b_size ? b[i] : 0);
+        result[i] = static_cast<limb_type>(carry);
+        carry >>= kLimbBits;
+    }
+    result[a_size] = static_cast<limb_type>(carry);
+    Trim(&result);
+    return result;
+}
+
+limbs_type MultiplySchoolbook(const limb_type* a, size_t a_size, const limb_type* b,
+                              size_t b_size) {
+    limbs_type result(a_size + b_size);
+    for (size_t i = 0; i < a_size; ++i) {
+        wide_type carry = 0;
+        for (size_t j = 0; j < b_size; ++j) {
+            carry += static_cast<wide_type>(a[i]) * b[j] + result[i + j];
+            result[i + j] = static_cast<limb_type>(carry);
+            carry >>= kLimbBits;
+        }
+        result[i + b_size] = static_cast<limb_type>(carry);
+    }
+    Trim(&result);
+    return result;
+}
+
+// Karatsuba: with a = a1 * B^m + a0 and b = b1 * B^m + b0,
+// a * b = z2 * B^2m + ((a0 + a1)(b0 + b1) - z2 - z0) * B^m + z0
+limbs_type Multiply(const limb_type* a, size_t a_size, const limb_type* b, size_t b_size) {
+    if (a_size < b_size) {
+        return Multiply(b, b_size, a, a_size);
+    }
+    if (b_size == 0) {
+        return {};
+    }
+    if (b_size < kKaratsubaThreshold) {
+        return MultiplySchoolbook(a, a_size, b, b_size);
+    }
+
+    limbs_type result(a_size + b_size + 1);
+
+    // An unbalanced product is a sum of balanced ones over slices of the longer factor
+    if (a_size >= 2 * b_size) {
+        for (size_t offset = 0; offset < a_size; offset += b_size) {
+            size_t slice = a_size - offset < b_size ? a_size - offset : b_size;
+            AddShifted(&result, Multiply(a + offset, slice, b, b_size), offset);
+        }
+        Trim(&result);
+        return result;
+    }
+
+    size_t half = a_size / 2;
+    size_t a0_size = half;
+    size_t b0_size = half;
+    while (a0_size > 0 && a[a0_size - 1] == 0) {
+        --a0_size;
+    }
+    while (b0_size > 0 && b[b0_size - 1] == 0) {
+        --b0_size;
+    }
+
+    limbs_type low = Multiply(a, a0_size, b, b0_size);
+    limbs_type high = Multiply(a + half, a_size - half, b + half, b_size - half);
+    limbs_type a_sum = Sum(a, a0_size, a + half, a_size - half);
+    limbs_type b_sum = Sum(b, b0_size, b + half, b_size - half);
+    limbs_type middle = Multiply(a_sum.data(), a_sum.size(), b_sum.data(), b_sum.size());
+    SubtractFrom(&middle, low);
+    SubtractFrom(&middle, high);
+    Trim(&middle);
+
+    AddShifted(&result, low, 0);
+    AddShifted(&result, middle, half);
+    AddShifted(&result, high, 2 * half);
+    Trim(&result);
+    return result;
+}
+// Multiplication
+
+// Division
+
+// Divides in place by a single limb and returns the remainder
+limb_type DivideBySmall(limbs_type* limbs, limb_type divisor) {
+    wide_type remainder = 0;
+    for (size_t i = limbs->size(); i > 0; --i) {
+        wide_type current = (remainder << kLimbBits) | (*limbs)[i - 1];
+        (*limbs)[i - 1] = static_cast<limb_type>(current / divisor);
+        remainder = current % divisor;
+    }
+    Trim(limbs);
+    return static_cast<limb_type>(remainder);
+}
+
+// The same with a divisor known at compile time, which turns the divisions into multiplications
+template <limb_type Divisor>
+limb_type DivideBySmall(limbs_type* limbs) {
+    wide_type remainder = 0;
+    for (size_t i = limbs->size(); i > 0; --i) {
+        wide_type current = (remainder << kLimbBits) | (*limbs)[i - 1];
+        (*limbs)[i - 1] = static_cast<limb_type>(current / Divisor);
+        remainder = current % Divisor;
+    }
+    Trim(limbs);
+    return static_cast<limb_type>(remainder);
+}
+
+void MultiplyAddSmall(limbs_type* limbs, limb_type factor, limb_type addend) {
+    wide_type carry = addend;
+    for (limb_type& limb : *limbs) {
+        carry += static_cast<wide_type>(limb) * factor;
+        limb = static_cast<limb_type>(carry);
+        carry >>= kLimbBits;
+    }
+    if (carry != 0) {
+        limbs->push_back(static_cast<limb_type>(carry));
+    }
+}
+
+int LeadingZeros(limb_type limb) {
+    int count = 0;
+    for (limb_type bit = limb_type{1} << (kLimbBits - 1); (limb & bit) == 0; bit >>= 1) {
+        ++count;
+    }
+    return count;
+}
+
+limbs_type ShiftLeft(const limbs_type& limbs, int shift, size_t size) {
+    limbs_type result(size);
+    for (size_t i = 0; i < limbs.size(); ++i) {
+        wide_type shifted = static_cast<wide_type>(limbs[i]) << shift;
+        result[i] |= static_cast<limb_type>(shifted);
+        result[i + 1] |= static_cast<limb_type>(shifted >> kLimbBits);
+    }
+    return result;
+}
+
+// Knuth's algorithm D: the divisor is normalized so that its top bit is set, which keeps
+// every estimated quotient limb at most two above the true one.
+// Requires |divisor| > 0, stores |dividend| / |divisor| and |dividend| % |divisor|
+void DivideMagnitude(const limbs_type& dividend, const limbs_type& divisor, limbs_type* quotient,
+                     limbs_type* remainder) {
+    if (CompareMagnitude(dividend, divisor) < 0) {
+        *quotient = {};
+        *remainder = dividend;
+        return;
+    }
+    if (divisor.size() == 1) {
+        *quotient = dividend;
+        limb_type rest = DivideBySmall(quotient, divisor[0]);
+        *remainder = rest == 0 ? limbs_type{} : limbs_type{rest};
+        return;
+    }
+
+    size_t n = divisor.size();
+    size_t m = dividend.size() - n;
+    int shift = LeadingZeros(divisor.back());
+    limbs_type v = ShiftLeft(divisor, shift, n + 1);
+    limbs_type u = ShiftLeft(dividend, shift, dividend.size() + 1);
+    quotient->assign(m + 1, 0);
+
+    for (size_t j = m + 1; j > 0; --j) {
+        size_t k = j - 1;
+        wide_type top = (static_cast<wide_type>(u[k + n]) << kLimbBits) | u[k + n - 1];
+        wide_type estimate = top / v[n - 1];
+        wide_type rest = top % v[n - 1];
+        while (estimate > kLimbMask ||
+               estimate * v[n - 2] > ((rest << kLimbBits) | u[k + n - 2])) {
+            --estimate;
+            rest += v[n - 1];
+            if (rest > kLimbMask) {
+                break;
+            }
+        }
+
+        // u[k...k + n] -= estimate * v
+        wide_type carry = 0;
+        limb_type borrow = 0;
+        for (size_t i = 0; i < n; ++i) {
+            carry += estimate * v[i];
+            wide_type subtrahend = (carry & kLimbMask) + borrow;
+            borrow = u[i + k] < subtrahend ? 1 : 0;
+            u[i + k] = static_cast<limb_type>(u[i + k] - subtrahend);
+            carry >>= kLimbBits;
+        }
+        wide_type subtrahend = carry + borrow;
+        borrow = u[k + n] < subtrahend ? 1 : 0;
+        u[k + n] = static_cast<limb_type>(u[k + n] - subtrahend);
+
+        // The estimate was one too large, add the divisor back
+        if (borrow != 0) {
+            --estimate;
+            wide_type sum = 0;
+            for (size_t i = 0; i < n; ++i) {
+                sum += static_cast<wide_type>(u[i + k]) + v[i];
+                u[i + k] = static_cast<limb_type>(sum);
+                sum >>= kLimbBits;
+            }
+            u[k + n] = static_cast<limb_type>(u[k + n] + sum);
+        }
+        (*quotient)[k] = static_cast<limb_type>(estimate);
+    }
+    Trim(quotient);
+
+    remainder->assign(n, 0);
+    for (size_t i = 0; i < n; ++i) {
+        wide_type pair = (static_cast<wide_type>(u[i + 1]) << kLimbBits) | u[i];
+        (*remainder)[i] = static_cast<limb_type>(pair >> shift);
+    }
+    Trim(remainder);
+}
+// Division
+
+// Decimal conversion
+
+// Below this many limbs chunks are peeled off one division by 10^9 at a time
+constexpr size_t kDecimalSplitThreshold = 64;
+
+// powers[k] = 10^(9 * 2^k)
+using powers_type = std::vector<limbs_type>;
+
+void AppendChunks(limbs_type value, size_t digits, std::string* out) {
+    std::vector<limb_type> chunks;
+    while (!value.empty()) {
+        chunks.push_back(DivideBySmall<kDecimalChunk>(&value));
+    }
+
+    std::string text;
+    for (size_t i = chunks.size(); i > 0; --i) {
+        std::string chunk = std::to_string(chunks[i - 1]);
+        if (i != chunks.size()) {
+            text.append(kDecimalChunkDigits - chunk.size(), '0');
+        }
+        text += chunk;
+    }
+    if (text.size() < digits) {
+        out->append(digits - text.size(), '0');
+    }
+    *out += text;
+}
+
+// Appends value < powers[level]^2, zero-padded to 9 * 2^(level + 1) digits if pad is set,
+// by splitting it into halves around powers[level]
+void AppendDecimal(const limbs_type& value, size_t level, const powers_type& powers, bool pad,
+                   std::string* out) {
+    size_t digits = pad ? kDecimalChunkDigits << (level + 1) : 0;
+    if (level == 0 || value.size() <= kDecimalSplitThreshold) {
+        AppendChunks(value, digits, out);
+        return;
+    }
+    if (!pad && CompareMagnitude(value, powers[level]) < 0) {
+        AppendDecimal(value, level - 1, powers, false, out);
+        return;
+    }
+
+    limbs_type high;
+    limbs_type low;
+    DivideMagnitude(value, powers[level], &high, &low);
+    AppendDecimal(high, level - 1, powers, pad, out);
+    AppendDecimal(low, level - 1, powers, true, out);
+}
+// Decimal conversion
+
+}  // namespace
+
+// BigInteger
+BigInteger::BigInteger(int value) : negative_(value < 0) {
+    wide_type magnitude = negative_ ? 0 - static_cast<wide_type>(static_cast<long long>(value))
+                                    : static_cast<wide_type>(value);
+    if (magnitude != 0) {
+        limbs_.push_back(static_cast<limb_type>(magnitude));
+    }
+}
+
+std::string BigInteger::toString() const {
+    if (limbs_.empty()) {
+        return "0";
+    }
+
+    powers_type powers = {{kDecimalChunk}};
+    while (CompareMagnitude(limbs_, powers.back()) >= 0) {
+        const limbs_type& last = powers.back();
+        powers.push_back(Multiply(last.data(), last.size(), last.data(), last.size()));
+    }
+
+    std::string result = negative_ ? "-" : "";
+    if (powers.size() == 1) {
+        AppendChunks(limbs_, 0, &result);
+    } else {
+        AppendDecimal(limbs_, powers.size() - 2, powers, false, &result);
+    }
+    return result;
+}
+
+BigInteger::operator bool() const {
+    return !limbs_.empty();
+}
+
+BigInteger BigInteger::operator-() const {
+    BigInteger result = *this;
+    result.negative_ = !negative_ && !limbs_.empty();
+    return result;
+}
+
+BigInteger& BigInteger::operator+=(const BigInteger& other) {
+    if (negative_ == other.negative_) {
+        AddMagnitude(other.limbs_);
+    } else if (CompareMagnitude(limbs_, other.limbs_) >= 0) {
+        SubtractMagnitude(other.limbs_);
+    } else {
+        limbs_type difference = other.limbs_;
+        SubtractFrom(&difference, limbs_);
+        limbs_.swap(difference);
+        negative_ = other.negative_;
+    }
+    Normalize();
+    return *this;
+}
+
+BigInteger& BigInteger::operator-=(const BigInteger& other) {
+    if (this == &other) {
+        *this = BigInteger();
+        return *this;
+    }
+    negative_ = !negative_;
+    *this += other;
+    negative_ = !negative_ && !limbs_.empty();
+    return *this;
+}
+
+BigInteger& BigInteger::operator*=(const BigInteger& other) {
+    limbs_ = Multiply(limbs_.data(), limbs_.size(), other.limbs_.data(), other.limbs_.size());
+    negative_ = negative_ != other.negative_;
+    Normalize();
+    return *this;
+}
+
+BigInteger& BigInteger::operator/=(const BigInteger& other) {
+    limbs_type quotient;
+    limbs_type remainder;
+    DivideMagnitude(limbs_, other.limbs_, &quotient, &remainder);
+    limbs_.swap(quotient);
+    negative_ = negative_ != other.negative_;
+    Normalize();
+    return *this;
+}
+
+BigInteger& BigInteger::operator%=(const BigInteger& other) {
+    limbs_type quotient;
+    limbs_type remainder;
+    DivideMagnitude(limbs_, other.limbs_, &quotient, &remainder);
+    limbs_.swap(remainder);
+    Normalize();
+    return *this;
+}
+
+BigInteger& BigInteger::operator++() {
+    static const limbs_type kOne = {1};
+    if (negative_) {
+        SubtractMagnitude(kOne);
+    } else {
+        AddMagnitude(kOne);
+    }
+    Normalize();
+    return *this;
+}
+
+BigInteger& BigInteger::operator--() {
+    static const limbs_type kOne = {1};
+    if (limbs_.empty()) {
+        *this = -1;
+    } else if (negative_) {
+        AddMagnitude(kOne);
+    } else {
+        SubtractMagnitude(kOne);
+    }
+    Normalize();
+    return *this;
+}
+
+BigInteger BigInteger::operator++(int) {
+    BigInteger old = *this;
+    ++*this;
+    return old;
+}
+
+BigInteger BigInteger::operator--(int) {
+    BigInteger old = *this;
+    --*this;
+    return old;
+}
+
+void BigInteger::AddMagnitude(const limbs_type& other) {
+    if (limbs_.size() < other.size()) {
+        limbs_.resize(other.size());
+    }
+
+    wide_type carry = 0;
+    size_t i = 0;
+    for (; i < other.size(); ++i) {
+        carry += static_cast<wide_type>(limbs_[i]) + other[i];
+        limbs_[i] = static_cast<limb_type>(carry);
+        carry >>= kLimbBits;
+    }
+    for (; carry != 0 && i < limbs_.size(); ++i) {
+        carry += limbs_[i];
+        limbs_[i] = static_cast<limb_type>(carry);
+        carry >>= kLimbBits;
+    }
+    if (carry != 0) {
+        limbs_.push_back(static_cast<limb_type>(carry));
+    }
+}
+
+void BigInteger::SubtractMagnitude(const limbs_type& other) {
+    SubtractFrom(&limbs_, other);
+}
+
+void BigInteger::Normalize() {
+    Trim(&limbs_);
+    if (limbs_.empty()) {
+        negative_ = false;
+    }
+}
+
+bool BigInteger::Parse(const std::string& text) {
+    size_t pos = 0;
+    bool negative = false;
+    if (pos < text.size() && (text[pos] == '-' || text[pos] == '+')) {
+        negative = text[pos] == '-';
+        ++pos;
+    }
+    if (pos == text.size()) {
+        return false;
+    }
+
+    limbs_type limbs;
+    while (pos < text.size()) {
+        size_t end = pos + kDecimalChunkDigits;
+        if (end > text.size()) {
+            end = text.size();
+        }
+        limb_type chunk = 0;
+        limb_type scale = 1;
+        for (; pos < end; ++pos) {
+            if (text[pos] < '0' || text[pos] > '9') {
+                return false;
+            }
+            chunk = chunk * 10 + static_cast<limb_type>(text[pos] - '0');
+            scale *= 10;
+        }
+        MultiplyAddSmall(&limbs, scale, chunk);
+    }
+
+    limbs_.swap(limbs);
+    negative_ = negative;
+    Normalize();
+    return true;
+}
+// BigInteger
+
+// Non-member functions
+BigInteger operator+(BigInteger lhs, const BigInteger& rhs) {
+    return lhs += rhs;
+}
+
+BigInteger operator-(BigInteger lhs, const BigInteger& rhs) {
+    return lhs -= rhs;
+}
+
+BigInteger operator*(BigInteger lhs, const BigInteger& rhs) {
+    return lhs *= rhs;
+}
+
+BigInteger operator/(BigInteger lhs, const BigInteger& rhs) {
+    return lhs /= rhs;
+}
+
+BigInteger operator%(BigInteger lhs, const BigInteger& rhs) {
+    return lhs %= rhs;
+}
+
+bool operator==(const BigInteger& lhs, const BigInteger& rhs) {
+    return lhs.negative_ == rhs.negative_ && lhs.limbs_ == rhs.limbs_;
+}
+
+bool operator<(const BigInteger& lhs, const BigInteger& rhs) {
+    if (lhs.negative_ != rhs.negative_) {
+        return lhs.negative_;
+    }
+    int compare = CompareMagnitude(lhs.limbs_, rhs.limbs_);
+    return lhs.negative_ ? compare > 0 : compare < 0;
+}
+
+bool operator!=(const BigInteger& lhs, const BigInteger& rhs) {
+    return !(lhs == rhs);
+}
+
+bool operator>(const BigInteger& lhs, const BigInteger& rhs) {
+    return rhs < lhs;
+}
+
+bool operator<=(const BigInteger& lhs, const BigInteger& rhs) {
+    return !(rhs < lhs);
+}
+
+bool operator>=(const BigInteger& lhs, const BigInteger& rhs) {
+    return !(lhs < rhs);
+}
+
+std::ostream& operator<<(std::ostream& os, const BigInteger& value) {
+    return os << value.toString();
+}
+
+std::istream& operator>>(std::istream& is, BigInteger& value) {
+    std::string text;
+    if (is >> text && !value.Parse(text)) {
+        is.setstate(std::ios::failbit);
+    }
+    return is;
+}
+// Non-member functions
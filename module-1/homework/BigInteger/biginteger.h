@@ -0,0 +1,72 @@
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Sign and magnitude; the magnitude is little-endian in base 2^32 limbs with no
+// leading zero limbs, so zero has no limbs and is never negative
+class BigInteger {
+public:
+    using limb_type = unsigned int;
+    using wide_type = unsigned long long;
+    using limbs_type = std::vector<limb_type>;
+
+    static_assert(sizeof(limb_type) * 2 == sizeof(wide_type), "limbs are half of a wide word");
+
+    BigInteger() = default;
+
+    BigInteger(int value);  // NOLINT
+
+    std::string toString() const;
+
+    explicit operator bool() const;
+
+    BigInteger operator-() const;
+
+    BigInteger& operator+=(const BigInteger& other);
+    BigInteger& operator-=(const BigInteger& other);
+    BigInteger& operator*=(const BigInteger& other);
+
+    // Division truncates toward zero and the remainder takes the sign of the dividend,
+    // as for int; the divisor must not be zero
+    BigInteger& operator/=(const BigInteger& other);
+    BigInteger& operator%=(const BigInteger& other);
+
+    // Carries stop at the first limb that does not overflow, so these are O(1) on average
+    BigInteger& operator++();
+    BigInteger& operator--();
+    BigInteger operator++(int);
+    BigInteger operator--(int);
+
+    friend bool operator==(const BigInteger& lhs, const BigInteger& rhs);
+    friend bool operator<(const BigInteger& lhs, const BigInteger& rhs);
+
+    friend std::istream& operator>>(std::istream& is, BigInteger& value);
+
+private:
+    // |this| += |other| and |this| -= |other|, the latter for |this| >= |other|
+    void AddMagnitude(const limbs_type& other);
+    void SubtractMagnitude(const limbs_type& other);
+
+    void Normalize();
+
+    // Returns false if text is not an optionally signed decimal number
+    bool Parse(const std::string& text);
+
+    limbs_type limbs_;
+    bool negative_ = false;
+};
+
+BigInteger operator+(BigInteger lhs, const BigInteger& rhs);
+BigInteger operator-(BigInteger lhs, const BigInteger& rhs);
+BigInteger operator*(BigInteger lhs, const BigInteger& rhs);
+BigInteger operator/(BigInteger lhs, const BigInteger& rhs);
+BigInteger operator%(BigInteger lhs, const BigInteger& rhs);
+
+bool operator!=(const BigInteger& lhs, const BigInteger& rhs);
+bool operator>(const BigInteger& lhs, const BigInteger& rhs);
+bool operator<=(const BigInteger& lhs, const BigInteger& rhs);
+bool operator>=(const BigInteger& lhs, const BigInteger& rhs);
+
+std::ostream& operator<<(std::ostream& os, const BigInteger& value);
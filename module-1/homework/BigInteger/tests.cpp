@@ -104,6 +104,37 @@ TEST(Comparison, Test1) {
     ASSERT_EQ(oss.str(), "010101");
 }
 
+TEST(Arithmetic, Test2) {
+    const size_t digits = 3000;
+    BigInteger nines;
+    std::istringstream(std::string(digits, '9')) >> nines;
+
+    // (10^n - 1)^2 = 10^2n - 2 * 10^n + 1
+    BigInteger square = nines * nines;
+    std::string expected = std::string(digits - 1, '9') + "8" + std::string(digits - 1, '0') + "1";
+    ASSERT_EQ(square.toString(), expected);
+
+    ASSERT_EQ((square / nines).toString(), nines.toString());
+    ASSERT_FALSE(bool(square % nines));
+    ASSERT_EQ(((square + 12345) % nines).toString(), "12345");
+    ASSERT_EQ((-square / nines * nines + square).toString(), "0");
+}
+
+TEST(Arithmetic, Test3) {
+    BigInteger value;
+    std::istringstream("4294967295") >> value;
+    ASSERT_EQ((++value).toString(), "4294967296");
+    ASSERT_EQ((value--).toString(), "4294967296");
+    ASSERT_EQ(value.toString(), "4294967295");
+
+    BigInteger zero = 0;
+    ASSERT_EQ((--zero).toString(), "-1");
+    ASSERT_EQ((++zero).toString(), "0");
+    ASSERT_EQ(BigInteger(-2147483647 - 1).toString(), "-2147483648");
+    ASSERT_EQ((BigInteger(-7) / 2).toString(), std::to_string(-7 / 2));
+    ASSERT_EQ((BigInteger(-7) % 2).toString(), std::to_string(-7 % 2));
+}
+
 int main(int argc, char** argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
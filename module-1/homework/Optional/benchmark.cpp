@@ -0,0 +1,124 @@
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#include "optional.h"
+
+// Construct/reset cycles of an Optional over a 4 KiB payload, and copies of a vector of 10M
+// trivially copyable optionals. Not part of the test run, which adds sanitizers; take numbers
+// from an optimized build, e.g.
+//   g++ -std=c++17 -O2 benchmark.cpp -o benchmark
+
+namespace {
+
+constexpr int32_t kCycles = 1'000'000;
+constexpr size_t kBufferSize = 4096;
+constexpr size_t kVectorSize = 10'000'000;
+constexpr int32_t kCopies = 20;
+
+int64_t constructions = 0;
+
+struct HeavyBuffer {
+    HeavyBuffer() {
+        ++constructions;
+        std::memset(data, 0, kBufferSize);
+    }
+
+    explicit HeavyBuffer(char fill) {
+        ++constructions;
+        std::memset(data, fill, kBufferSize);
+    }
+
+    char data[kBufferSize];
+};
+
+// Makes the object look read, so that the compiler keeps the stores into it
+template <typename T>
+void Escape(T& value) {
+    asm volatile("" : : "r"(&value) : "memory");
+}
+
+template <typename F>
+double Milliseconds(F&& f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+        .count();
+}
+
+void Report(const char* name, double ms) {
+    std::cout << "  " << name << ms << " ms, " << static_cast<double>(constructions) / kCycles
+              << " constructions per cycle\n";
+    constructions = 0;
+}
+
+struct Point {
+    int32_t x;
+    int32_t y;
+};
+
+// Copy-assigns a vector of optionals into a preallocated one and grows another by push_back, so
+// both the copy loop and the reallocation move are timed
+template <typename T, typename Make>
+void CopyVector(const char* name, Make make, int64_t& sum) {
+    std::vector<task::Optional<T>> source;
+    source.reserve(kVectorSize);
+    for (size_t i = 0; i < kVectorSize; ++i) {
+        source.push_back(i % 4 == 0 ? task::Optional<T>() : task::Optional<T>(make(i)));
+    }
+    std::vector<task::Optional<T>> target(kVectorSize);
+
+    double ms = Milliseconds([&] {
+        for (int32_t i = 0; i < kCopies; ++i) {
+            target = source;
+            Escape(target);
+            sum += target[i].HasValue();
+        }
+    });
+    std::cout << "  " << name << " copy " << ms / kCopies << " ms";
+
+    ms = Milliseconds([&] {
+        std::vector<task::Optional<T>> grown;
+        for (size_t i = 0; i < kVectorSize; ++i) {
+            grown.push_back(source[i]);
+        }
+        sum += grown.back().HasValue();
+    });
+    std::cout << ", push_back " << ms << " ms\n";
+}
+
+}  // namespace
+
+int main() {
+    int64_t sum = 0;
+    std::cout << kCycles << " cycles over a " << kBufferSize << " byte payload\n";
+
+    double ms = Milliseconds([&] {
+        for (int32_t i = 0; i < kCycles; ++i) {
+            task::Optional<HeavyBuffer> empty;
+            Escape(empty);
+            sum += empty.HasValue();
+        }
+    });
+    Report("empty optional    ", ms);
+
+    ms = Milliseconds([&] {
+        for (int32_t i = 0; i < kCycles; ++i) {
+            task::Optional<HeavyBuffer> buffer(task::kInPlace, static_cast<char>(i));
+            Escape(buffer);
+            sum += buffer->data[i % kBufferSize];
+            buffer.Reset();
+        }
+    });
+    Report("construct + reset ", ms);
+
+    std::cout << kVectorSize << " optionals per vector\n";
+    CopyVector<int32_t>("Optional<int32_t>", [](size_t i) { return static_cast<int32_t>(i); }, sum);
+    CopyVector<Point>(
+        "Optional<Point>  ",
+        [](size_t i) { return Point{static_cast<int32_t>(i), static_cast<int32_t>(i / 2)}; }, sum);
+
+    return sum == 0 ? 1 : 0;
+}
@@ -1,5 +1,13 @@
+#include <cstdint>
 #include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
 #include <type_traits>
+#include <utility>
 
 #pragma once
 
@@ -17,99 +25,411 @@ struct InPlace {
 
 constexpr InPlace kInPlace{};
 
-template <typename T, bool>
-class OptionalDestructBase {
+// NicheTraits - customization point for types with a bit pattern that is never a valid
+// value. A specialization sets kHasNiche and provides Empty(), the value stored while
+// the optional is disengaged, and IsEmpty(value); Optional<T> is then sizeof(T).
+// The type must be trivially copyable and trivially destructible. Nothing has a niche
+// by default: a pointer or a float may legitimately hold any bit pattern, so a program
+// opts in for its own types, e.g. with PointerNicheTraits or FloatNicheTraits below.
+// Engaging an optional with the sentinel throws std::invalid_argument
+template <typename T>
+struct NicheTraits {
+    static constexpr bool kHasNiche = false;
+};
+
+// Forbids the all-ones address, which mmap also returns as MAP_FAILED:
+// template <> struct NicheTraits<Node*> : PointerNicheTraits<Node> {};
+template <typename T>
+struct PointerNicheTraits {
+    static constexpr bool kHasNiche = true;
+
+    static T* Empty() noexcept {
+        return reinterpret_cast<T*>(std::numeric_limits<uintptr_t>::max());
+    }
+
+    static bool IsEmpty(T* value) noexcept {
+        return value == Empty();
+    }
+};
+
+// Forbids one NaN payload, compared bitwise; F is a floating-point type or a wrapper
+// of the same size, e.g. FloatNicheTraits<Ratio, uint32_t, 0x7fc0dead>
+template <typename F, typename Bits, Bits kPattern>
+struct FloatNicheTraits {
+    static_assert(sizeof(F) == sizeof(Bits));
+
+    static constexpr bool kHasNiche = true;
+
+    static F Empty() noexcept {
+        Bits bits = kPattern;
+        F value;
+        std::memcpy(&value, &bits, sizeof(F));
+        return value;
+    }
+
+    static bool IsEmpty(F value) noexcept {
+        Bits bits;
+        std::memcpy(&bits, &value, sizeof(F));
+        return bits == kPattern;
+    }
+};
+// NicheTraits
+
+// The value lives in a union, so a disengaged Optional never constructs a T:
+// it is placement-constructed on engage and destroyed on reset. The destructor is trivial
+// exactly when T's is. The default constructor names no member: initializing any of them
+// would make GCC zero the whole payload, i.e. write sizeof(T) bytes for every empty optional
+template <typename T, bool = std::is_trivially_destructible_v<T>>
+union OptionalPayload {
+    constexpr OptionalPayload() noexcept {
+    }
+
+    template <typename... Args>
+    constexpr explicit OptionalPayload(InPlace, Args&&... args)
+        : value(std::forward<Args>(args)...) {
+    }
+
+    T value;
+};
+
+template <typename T>
+union OptionalPayload<T, false> {
+    constexpr OptionalPayload() noexcept {
+    }
+
+    template <typename... Args>
+    constexpr explicit OptionalPayload(InPlace, Args&&... args)
+        : value(std::forward<Args>(args)...) {
+    }
+
+    ~OptionalPayload() {
+    }
+
+    T value;
+};
+
+template <typename T>
+class OptionalStorageBase {
 public:
-    constexpr OptionalDestructBase() : engaged_(false) {
+    constexpr OptionalStorageBase() noexcept : engaged_(false) {
     }
 
-    constexpr explicit OptionalDestructBase(NullOpt) : engaged_(false) {
+    constexpr explicit OptionalStorageBase(NullOpt) noexcept : engaged_(false) {
     }
 
     template <typename U = T>
-    constexpr explicit OptionalDestructBase(U&& val)
-        : value_(std::forward<U>(val)), engaged_(true) {
+    constexpr explicit OptionalStorageBase(U&& val)
+        : payload_(kInPlace, std::forward<U>(val)), engaged_(true) {
     }
 
     template <typename... Args>
-    constexpr explicit OptionalDestructBase(InPlace, Args&&... args)
-        : value_(std::forward<Args>(args)...), engaged_(true) {
+    constexpr explicit OptionalStorageBase(InPlace, Args&&... args)
+        : payload_(kInPlace, std::forward<Args>(args)...), engaged_(true) {
+    }
+
+    constexpr bool IsEngaged() const noexcept {
+        return engaged_;
     }
 
 protected:
+    // With the payload left uninitialized GCC warns that reads on paths only taken while
+    // engaged may see garbage; laundering hides value from that analysis
+    constexpr T& Value() noexcept {
+        return *std::launder(std::addressof(payload_.value));
+    }
+
+    constexpr const T& Value() const noexcept {
+        return *std::launder(std::addressof(payload_.value));
+    }
+
+    // Expects a disengaged optional
+    template <typename... Args>
+    void Construct(Args&&... args) {
+        ::new (static_cast<void*>(std::addressof(payload_.value)))
+            T(std::forward<Args>(args)...);
+        engaged_ = true;
+    }
+
     template <typename U = T>
     void Set(U&& value) {
-        value_ = std::forward<U>(value);
-        engaged_ = true;
+        if (engaged_) {
+            Value() = std::forward<U>(value);
+        } else {
+            Construct(std::forward<U>(value));
+        }
     }
 
     void ResetHelper() {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            if (engaged_) {
+                Value().~T();
+            }
+        }
         engaged_ = false;
     }
 
-    T value_;
-
+    OptionalPayload<T> payload_;
     bool engaged_;
 };
 
+// Trivially destructible T leaves the destructor implicit and trivial
+template <typename T, bool>
+class OptionalDestructBase : public OptionalStorageBase<T> {
+public:
+    using OptionalStorageBase<T>::OptionalStorageBase;
+};
+
+template <typename T>
+class OptionalDestructBase<T, false> : public OptionalStorageBase<T> {
+public:
+    using OptionalStorageBase<T>::OptionalStorageBase;
+
+    OptionalDestructBase() = default;
+    OptionalDestructBase(const OptionalDestructBase&) = default;
+    OptionalDestructBase(OptionalDestructBase&&) = default;
+    OptionalDestructBase& operator=(const OptionalDestructBase&) = default;
+    OptionalDestructBase& operator=(OptionalDestructBase&&) = default;
+
+    ~OptionalDestructBase() {
+        this->ResetHelper();
+    }
+};
+
+// Types with a niche keep the sentinel in the value itself instead of a separate flag
 template <typename T>
-class OptionalDestructBase<T, false> {
+class OptionalNicheBase {
 public:
-    constexpr OptionalDestructBase() : engaged_(false) {
+    static_assert(std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T>,
+                  "NicheTraits may only be specialized for trivial types");
+
+    using traits = NicheTraits<T>;
+
+    OptionalNicheBase() noexcept : value_(traits::Empty()) {
     }
 
-    constexpr explicit OptionalDestructBase(NullOpt) : engaged_(false) {
+    explicit OptionalNicheBase(NullOpt) noexcept : value_(traits::Empty()) {
     }
 
     template <typename U = T>
-    constexpr explicit OptionalDestructBase(U&& val)
-        : value_(std::forward<U>(val)), engaged_(true) {
+    explicit OptionalNicheBase(U&& val) : value_(std::forward<U>(val)) {
+        CheckEngaged();
     }
 
     template <typename... Args>
-    constexpr explicit OptionalDestructBase(InPlace, Args&&... args)
-        : value_(std::forward<Args>(args)...), engaged_(true) {
+    explicit OptionalNicheBase(InPlace, Args&&... args)
+        : value_(std::forward<Args>(args)...) {
+        CheckEngaged();
     }
 
-    ~OptionalDestructBase() {
-        if (engaged_) {
-            value_.~T();
-        }
+    bool IsEngaged() const noexcept {
+        return !traits::IsEmpty(value_);
     }
 
 protected:
+    constexpr T& Value() noexcept {
+        return value_;
+    }
+
+    constexpr const T& Value() const noexcept {
+        return value_;
+    }
+
+    // A sentinel value leaves the optional disengaged
+    template <typename... Args>
+    void Construct(Args&&... args) {
+        ::new (static_cast<void*>(std::addressof(value_))) T(std::forward<Args>(args)...);
+        CheckEngaged();
+    }
+
     template <typename U = T>
     void Set(U&& value) {
-        if (engaged_) {
-            value_.~T();
-        }
-        value_ = std::forward<U>(value);
-        engaged_ = true;
+        Construct(std::forward<U>(value));
     }
 
     void ResetHelper() {
-        if (engaged_) {
-            value_.~T();
+        value_ = traits::Empty();
+    }
+
+    void CheckEngaged() const {
+        if (traits::IsEmpty(value_)) {
+            throw std::invalid_argument("Engaging an optional with its NicheTraits sentinel");
         }
-        engaged_ = false;
     }
 
     T value_;
+};
 
-    bool engaged_;
+template <typename T>
+using optional_destruct_base_t =
+    std::conditional_t<NicheTraits<T>::kHasNiche, OptionalNicheBase<T>,
+                       OptionalDestructBase<T, std::is_trivially_destructible_v<T>>>;
+
+// Each of the layers below defines one special member only when T makes it non-trivial,
+// and otherwise leaves it implicit. Trivially copyable T therefore gives a trivially
+// copyable Optional, and members T cannot support stay implicitly deleted
+
+// OptionalCopyConstructBase
+template <typename T,
+          bool = std::is_trivially_copy_constructible_v<T> || !std::is_copy_constructible_v<T>>
+class OptionalCopyConstructBase : public optional_destruct_base_t<T> {
+private:
+    using base = optional_destruct_base_t<T>;
+
+public:
+    using base::base;
+};
+
+template <typename T>
+class OptionalCopyConstructBase<T, false> : public optional_destruct_base_t<T> {
+private:
+    using base = optional_destruct_base_t<T>;
+
+public:
+    using base::base;
+
+    OptionalCopyConstructBase() = default;
+
+    OptionalCopyConstructBase(const OptionalCopyConstructBase& other) : base() {
+        if (other.IsEngaged()) {
+            this->Construct(other.Value());
+        }
+    }
+
+    OptionalCopyConstructBase(OptionalCopyConstructBase&&) = default;
+    OptionalCopyConstructBase& operator=(const OptionalCopyConstructBase&) = default;
+    OptionalCopyConstructBase& operator=(OptionalCopyConstructBase&&) = default;
+};
+// OptionalCopyConstructBase
+
+// OptionalMoveConstructBase
+template <typename T,
+          bool = std::is_trivially_move_constructible_v<T> || !std::is_move_constructible_v<T>>
+class OptionalMoveConstructBase : public OptionalCopyConstructBase<T> {
+private:
+    using base = OptionalCopyConstructBase<T>;
+
+public:
+    using base::base;
+};
+
+template <typename T>
+class OptionalMoveConstructBase<T, false> : public OptionalCopyConstructBase<T> {
+private:
+    using base = OptionalCopyConstructBase<T>;
+
+public:
+    using base::base;
+
+    OptionalMoveConstructBase() = default;
+    OptionalMoveConstructBase(const OptionalMoveConstructBase&) = default;
+
+    OptionalMoveConstructBase(OptionalMoveConstructBase&& other) noexcept(
+        std::is_nothrow_move_constructible_v<T>)
+        : base() {
+        if (other.IsEngaged()) {
+            this->Construct(std::move(other.Value()));
+        }
+    }
+
+    OptionalMoveConstructBase& operator=(const OptionalMoveConstructBase&) = default;
+    OptionalMoveConstructBase& operator=(OptionalMoveConstructBase&&) = default;
+};
+// OptionalMoveConstructBase
+
+// OptionalCopyAssignBase
+template <typename T, bool = (std::is_trivially_copy_constructible_v<T> &&
+                              std::is_trivially_copy_assignable_v<T> &&
+                              std::is_trivially_destructible_v<T>) ||
+                             !(std::is_copy_constructible_v<T> && std::is_copy_assignable_v<T>)>
+class OptionalCopyAssignBase : public OptionalMoveConstructBase<T> {
+private:
+    using base = OptionalMoveConstructBase<T>;
+
+public:
+    using base::base;
 };
 
 template <typename T>
-class Optional : public OptionalDestructBase<T, std::is_trivially_destructible_v<T>> {
+class OptionalCopyAssignBase<T, false> : public OptionalMoveConstructBase<T> {
+private:
+    using base = OptionalMoveConstructBase<T>;
+
+public:
+    using base::base;
+
+    OptionalCopyAssignBase() = default;
+    OptionalCopyAssignBase(const OptionalCopyAssignBase&) = default;
+    OptionalCopyAssignBase(OptionalCopyAssignBase&&) = default;
+
+    OptionalCopyAssignBase& operator=(const OptionalCopyAssignBase& other) {
+        if (other.IsEngaged()) {
+            this->Set(other.Value());
+        } else {
+            this->ResetHelper();
+        }
+        return *this;
+    }
+
+    OptionalCopyAssignBase& operator=(OptionalCopyAssignBase&&) = default;
+};
+// OptionalCopyAssignBase
+
+// OptionalMoveAssignBase
+template <typename T, bool = (std::is_trivially_move_constructible_v<T> &&
+                              std::is_trivially_move_assignable_v<T> &&
+                              std::is_trivially_destructible_v<T>) ||
+                             !(std::is_move_constructible_v<T> && std::is_move_assignable_v<T>)>
+class OptionalMoveAssignBase : public OptionalCopyAssignBase<T> {
 private:
-    using base = OptionalDestructBase<T, std::is_trivially_destructible_v<T>>;
+    using base = OptionalCopyAssignBase<T>;
+
+public:
+    using base::base;
+};
+
+template <typename T>
+class OptionalMoveAssignBase<T, false> : public OptionalCopyAssignBase<T> {
+private:
+    using base = OptionalCopyAssignBase<T>;
+
+public:
+    using base::base;
+
+    OptionalMoveAssignBase() = default;
+    OptionalMoveAssignBase(const OptionalMoveAssignBase&) = default;
+    OptionalMoveAssignBase(OptionalMoveAssignBase&&) = default;
+    OptionalMoveAssignBase& operator=(const OptionalMoveAssignBase&) = default;
+
+    OptionalMoveAssignBase& operator=(OptionalMoveAssignBase&& other) noexcept(
+        std::is_nothrow_move_constructible_v<T>&& std::is_nothrow_move_assignable_v<T>) {
+        if (other.IsEngaged()) {
+            this->Set(std::move(other.Value()));
+        } else {
+            this->ResetHelper();
+        }
+        return *this;
+    }
+};
+// OptionalMoveAssignBase
+
+template <typename T>
+class Optional : public OptionalMoveAssignBase<T> {
+private:
+    using base = OptionalMoveAssignBase<T>;
+
+    // Keeps the value overloads away from copies, moves and the tag types
+    template <typename U>
+    using enable_if_value_t =
+        std::enable_if_t<!std::is_same_v<std::decay_t<U>, Optional> &&
+                         !std::is_same_v<std::decay_t<U>, NullOpt> &&
+                         !std::is_same_v<std::decay_t<U>, InPlace>>;
 
 public:
     using value_type = T;
 
     constexpr Optional() noexcept : base(){};
 
-    template <typename U = value_type>
+    template <typename U = value_type, typename = enable_if_value_t<U>>
     constexpr explicit Optional(U&& value);
 
     constexpr explicit Optional(NullOpt) noexcept;
@@ -119,7 +439,7 @@ public:
 
     Optional& operator=(NullOpt) noexcept;
 
-    template <typename U = T>
+    template <typename U = T, typename = enable_if_value_t<U>>
     Optional& operator=(U&& value);
 
     void Reset() noexcept;
@@ -130,6 +450,27 @@ public:
     template <typename U>
     constexpr T ValueOr(U&& default_value) &&;
 
+    // f() is only called, and the default only built, when the optional is empty
+    template <typename F>
+    constexpr T ValueOrElse(F&& f) const&;
+
+    template <typename F>
+    constexpr T ValueOrElse(F&& f) &&;
+
+    // f(value) must return an Optional; an empty optional yields an empty result
+    template <typename F>
+    constexpr auto AndThen(F&& f) const&;
+
+    template <typename F>
+    constexpr auto AndThen(F&& f) &&;
+
+    // Wraps f(value) into an Optional; an empty optional yields an empty result
+    template <typename F>
+    constexpr auto Transform(F&& f) const&;
+
+    template <typename F>
+    constexpr auto Transform(F&& f) &&;
+
     constexpr bool HasValue() const noexcept;
 
     constexpr explicit operator bool() const noexcept;
@@ -148,7 +489,7 @@ public:
 };
 
 template <typename T>
-template <typename U>
+template <typename U, typename>
 constexpr Optional<T>::Optional(U&& value) : base(std::forward<U>(value)) {
 }
 
@@ -158,7 +499,8 @@ constexpr Optional<T>::Optional(NullOpt) noexcept : base() {
 
 template <typename T>
 template <typename... Args>
-constexpr Optional<T>::Optional(InPlace, Args&&... args) : base(kInPlace, args...) {
+constexpr Optional<T>::Optional(InPlace, Args&&... args)
+    : base(kInPlace, std::forward<Args>(args)...) {
 }
 
 template <typename T>
@@ -168,9 +510,9 @@ Optional<T>& Optional<T>::operator=(NullOpt) noexcept {
 }
 
 template <typename T>
-template <typename U>
+template <typename U, typename>
 Optional<T>& Optional<T>::operator=(U&& value) {
-    Set(std::forward<U>(value));
+    this->Set(std::forward<U>(value));
     return *this;
 }
 
@@ -182,54 +524,256 @@ void Optional<T>::Reset() noexcept {
 template <typename T>
 template <typename U>
 constexpr T Optional<T>::ValueOr(U&& default_value) const& {
-    return this->engaged_ ? this->value_ : default_value;
+    if (this->IsEngaged()) {
+        return this->Value();
+    }
+    return static_cast<T>(std::forward<U>(default_value));
 }
 
 template <typename T>
 template <typename U>
 constexpr T Optional<T>::ValueOr(U&& default_value) && {
-    return this->engaged_ ? this->value_ : default_value;
+    if (this->IsEngaged()) {
+        return std::move(this->Value());
+    }
+    return static_cast<T>(std::forward<U>(default_value));
 }
 
 template <typename T>
 constexpr bool Optional<T>::HasValue() const noexcept {
-    return this->engaged_;
+    return this->IsEngaged();
 }
 
 template <typename T>
 constexpr Optional<T>::operator bool() const noexcept {
-    return this->engaged_;
+    return this->IsEngaged();
 }
 
 template <typename T>
 constexpr std::add_pointer_t<const typename Optional<T>::value_type> Optional<T>::operator->()
     const {
-    return &(this->value_);
+    return &(this->Value());
 }
 
 template <typename T>
 constexpr std::add_pointer_t<typename Optional<T>::value_type> Optional<T>::operator->() {
-    return &(this->value_);
+    return &(this->Value());
 }
 
 template <typename T>
 constexpr const typename Optional<T>::value_type& Optional<T>::operator*() const& {
-    return this->value_;
+    return this->Value();
 }
 
 template <typename T>
 constexpr typename Optional<T>::value_type& Optional<T>::operator*() & {
-    return this->value_;
+    return this->Value();
 }
 
 template <typename T>
 constexpr const typename Optional<T>::value_type&& Optional<T>::operator*() const&& {
-    return this->value_;
+    return std::move(this->Value());
 }
 
 template <typename T>
 constexpr typename Optional<T>::value_type&& Optional<T>::operator*() && {
-    return this->value_;
+    return std::move(this->Value());
+}
+
+template <typename T>
+template <typename F>
+constexpr T Optional<T>::ValueOrElse(F&& f) const& {
+    if (this->IsEngaged()) {
+        return this->Value();
+    }
+    return std::invoke(std::forward<F>(f));
+}
+
+template <typename T>
+template <typename F>
+constexpr T Optional<T>::ValueOrElse(F&& f) && {
+    if (this->IsEngaged()) {
+        return std::move(this->Value());
+    }
+    return std::invoke(std::forward<F>(f));
+}
+
+template <typename T>
+template <typename F>
+constexpr auto Optional<T>::AndThen(F&& f) const& {
+    using result_type = std::decay_t<std::invoke_result_t<F, const T&>>;
+    if (this->IsEngaged()) {
+        return std::invoke(std::forward<F>(f), this->Value());
+    }
+    return result_type();
+}
+
+template <typename T>
+template <typename F>
+constexpr auto Optional<T>::AndThen(F&& f) && {
+    using result_type = std::decay_t<std::invoke_result_t<F, T&&>>;
+    if (this->IsEngaged()) {
+        return std::invoke(std::forward<F>(f), std::move(this->Value()));
+    }
+    return result_type();
+}
+
+template <typename T>
+template <typename F>
+constexpr auto Optional<T>::Transform(F&& f) const& {
+    using result_type = Optional<std::remove_cv_t<std::invoke_result_t<F, const T&>>>;
+    if (this->IsEngaged()) {
+        return result_type(kInPlace, std::invoke(std::forward<F>(f), this->Value()));
+    }
+    return result_type();
+}
+
+template <typename T>
+template <typename F>
+constexpr auto Optional<T>::Transform(F&& f) && {
+    using result_type = Optional<std::remove_cv_t<std::invoke_result_t<F, T&&>>>;
+    if (this->IsEngaged()) {
+        return result_type(kInPlace, std::invoke(std::forward<F>(f), std::move(this->Value())));
+    }
+    return result_type();
+}
+
+// Optional<T&> - an optional reference, stored as a single pointer that is null while
+// empty. Assignment from a reference rebinds it and never assigns through it
+template <typename T>
+class Optional<T&> {
+public:
+    using value_type = T&;
+
+    constexpr Optional() noexcept = default;
+
+    constexpr explicit Optional(NullOpt) noexcept;
+
+    constexpr explicit Optional(T& value) noexcept;
+
+    constexpr explicit Optional(InPlace, T& value) noexcept;
+
+    // Binding to a temporary would dangle immediately
+    explicit Optional(T&&) = delete;
+
+    Optional& operator=(NullOpt) noexcept;
+
+    Optional& operator=(T& value) noexcept;
+
+    Optional& operator=(T&&) = delete;
+
+    void Reset() noexcept;
+
+    template <typename U>
+    constexpr std::remove_cv_t<T> ValueOr(U&& default_value) const;
+
+    template <typename F>
+    constexpr std::remove_cv_t<T> ValueOrElse(F&& f) const;
+
+    template <typename F>
+    constexpr auto AndThen(F&& f) const;
+
+    template <typename F>
+    constexpr auto Transform(F&& f) const;
+
+    constexpr bool HasValue() const noexcept;
+
+    constexpr explicit operator bool() const noexcept;
+
+    constexpr T* operator->() const noexcept;
+
+    constexpr T& operator*() const noexcept;
+
+private:
+    T* ptr_ = nullptr;
+};
+
+template <typename T>
+constexpr Optional<T&>::Optional(NullOpt) noexcept {
+}
+
+template <typename T>
+constexpr Optional<T&>::Optional(T& value) noexcept : ptr_(std::addressof(value)) {
+}
+
+template <typename T>
+constexpr Optional<T&>::Optional(InPlace, T& value) noexcept : ptr_(std::addressof(value)) {
+}
+
+template <typename T>
+Optional<T&>& Optional<T&>::operator=(NullOpt) noexcept {
+    ptr_ = nullptr;
+    return *this;
+}
+
+template <typename T>
+Optional<T&>& Optional<T&>::operator=(T& value) noexcept {
+    ptr_ = std::addressof(value);
+    return *this;
+}
+
+template <typename T>
+void Optional<T&>::Reset() noexcept {
+    ptr_ = nullptr;
+}
+
+template <typename T>
+template <typename U>
+constexpr std::remove_cv_t<T> Optional<T&>::ValueOr(U&& default_value) const {
+    if (ptr_ != nullptr) {
+        return *ptr_;
+    }
+    return static_cast<std::remove_cv_t<T>>(std::forward<U>(default_value));
+}
+
+template <typename T>
+template <typename F>
+constexpr std::remove_cv_t<T> Optional<T&>::ValueOrElse(F&& f) const {
+    if (ptr_ != nullptr) {
+        return *ptr_;
+    }
+    return std::invoke(std::forward<F>(f));
+}
+
+template <typename T>
+template <typename F>
+constexpr auto Optional<T&>::AndThen(F&& f) const {
+    using result_type = std::decay_t<std::invoke_result_t<F, T&>>;
+    if (ptr_ != nullptr) {
+        return std::invoke(std::forward<F>(f), *ptr_);
+    }
+    return result_type();
+}
+
+template <typename T>
+template <typename F>
+constexpr auto Optional<T&>::Transform(F&& f) const {
+    using result_type = Optional<std::remove_cv_t<std::invoke_result_t<F, T&>>>;
+    if (ptr_ != nullptr) {
+        return result_type(kInPlace, std::invoke(std::forward<F>(f), *ptr_));
+    }
+    return result_type();
+}
+
+template <typename T>
+constexpr bool Optional<T&>::HasValue() const noexcept {
+    return ptr_ != nullptr;
+}
+
+template <typename T>
+constexpr Optional<T&>::operator bool() const noexcept {
+    return ptr_ != nullptr;
+}
+
+template <typename T>
+constexpr T* Optional<T&>::operator->() const noexcept {
+    return ptr_;
+}
+
+template <typename T>
+constexpr T& Optional<T&>::operator*() const noexcept {
+    return *ptr_;
 }
+// Optional<T&>
 
 }  // namespace task
\ No newline at end of file
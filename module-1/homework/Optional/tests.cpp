@@ -1,4 +1,9 @@
+#include <cmath>
 #include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <stdexcept>
 #include <string>
 
 #include "gtest/gtest.h"
@@ -14,6 +19,61 @@ TEST(ValueOR, Test2) {
     ASSERT_EQ(opt.ValueOr("empty"), "empty");
 }
 
+struct MoveCounted {
+    explicit MoveCounted(std::string text) : text(std::move(text)) {
+    }
+
+    MoveCounted(const MoveCounted& other) : text(other.text), copies(other.copies + 1) {
+    }
+
+    MoveCounted(MoveCounted&& other) noexcept : text(std::move(other.text)), copies(other.copies) {
+    }
+
+    std::string text;
+    int copies = 0;
+};
+
+TEST(ValueOR, Test3) {
+    task::Optional<MoveCounted> opt(MoveCounted("Hello world"));
+    MoveCounted value = std::move(opt).ValueOr(MoveCounted("empty"));
+    ASSERT_EQ(value.text, "Hello world");
+    ASSERT_EQ(value.copies, 0);
+
+    int calls = 0;
+    auto fallback = [&calls] {
+        ++calls;
+        return std::string("empty");
+    };
+    task::Optional<std::string> str("Hello world");
+    ASSERT_EQ(str.ValueOrElse(fallback), "Hello world");
+    ASSERT_EQ(calls, 0);
+
+    str.Reset();
+    ASSERT_EQ(str.ValueOrElse(fallback), "empty");
+    ASSERT_EQ(calls, 1);
+}
+
+TEST(Monadic, Test1) {
+    auto parse = [](const std::string& text) {
+        return text.empty() ? task::Optional<int32_t>() : task::Optional<int32_t>(std::stoi(text));
+    };
+
+    task::Optional<std::string> str("42");
+    ASSERT_EQ(*str.AndThen(parse), 42);
+    ASSERT_EQ(*str.Transform([](const std::string& text) { return text.size(); }), 2u);
+    ASSERT_EQ(*std::move(str).Transform([](std::string&& text) { return text + "!"; }), "42!");
+
+    task::Optional<std::string> empty;
+    int calls = 0;
+    auto count = [&calls](const std::string& text) {
+        ++calls;
+        return text.size();
+    };
+    ASSERT_FALSE(empty.AndThen(parse).HasValue());
+    ASSERT_FALSE(empty.Transform(count).HasValue());
+    ASSERT_EQ(calls, 0);
+}
+
 TEST(HasValue, Test1) {
     task::Optional<std::string> opt("Hello world");
     ASSERT_TRUE(opt.HasValue());
@@ -40,6 +100,238 @@ TEST(IndirectionOperator, Test1) {
     ASSERT_EQ(*opt, 1);
 }
 
+struct Counted {
+    static inline int constructed = 0;
+    static inline int destroyed = 0;
+
+    Counted() {
+        ++constructed;
+    }
+
+    explicit Counted(int value) : value(value) {
+        ++constructed;
+    }
+
+    Counted(const Counted& other) : value(other.value) {
+        ++constructed;
+    }
+
+    ~Counted() {
+        ++destroyed;
+    }
+
+    Counted& operator=(const Counted&) = default;
+
+    int value = 0;
+};
+
+TEST(Storage, Test1) {
+    Counted::constructed = Counted::destroyed = 0;
+    {
+        task::Optional<Counted> opt;
+        ASSERT_EQ(Counted::constructed, 0);
+
+        opt = Counted(5);
+        ASSERT_EQ(Counted::constructed, 2);
+        ASSERT_EQ(Counted::destroyed, 1);
+        ASSERT_EQ(opt->value, 5);
+
+        opt.Reset();
+        ASSERT_EQ(Counted::destroyed, 2);
+
+        task::Optional<Counted> in_place(task::kInPlace, 7);
+        ASSERT_EQ(Counted::constructed, 3);
+        ASSERT_EQ(in_place->value, 7);
+    }
+    ASSERT_EQ(Counted::constructed, Counted::destroyed);
+}
+
+TEST(Storage, Test2) {
+    task::Optional<std::string> opt("Hello world");
+    task::Optional<std::string> copy(opt);
+    ASSERT_EQ(*copy, "Hello world");
+
+    task::Optional<std::string> empty;
+    copy = empty;
+    ASSERT_FALSE(copy.HasValue());
+
+    copy = std::move(opt);
+    ASSERT_EQ(*copy, "Hello world");
+
+    task::Optional<std::string> moved(std::move(copy));
+    ASSERT_EQ(*moved, "Hello world");
+}
+
+struct Point {
+    int32_t x;
+    int32_t y;
+};
+
+struct CopyOnly {
+    CopyOnly() = default;
+    CopyOnly(const CopyOnly&) {
+    }
+};
+
+template <typename T, bool TriviallyCopyable, bool Copyable, bool Movable>
+constexpr bool CheckTraits() {
+    using O = task::Optional<T>;
+    static_assert(std::is_trivially_copyable_v<O> == TriviallyCopyable);
+    static_assert(std::is_trivially_destructible_v<O> == std::is_trivially_destructible_v<T>);
+    static_assert(std::is_copy_constructible_v<O> == Copyable);
+    static_assert(std::is_copy_assignable_v<O> == Copyable);
+    static_assert(std::is_move_constructible_v<O> == Movable);
+    static_assert(std::is_move_assignable_v<O> == Movable);
+    return true;
+}
+
+TEST(Trivial, Test1) {
+    static_assert(CheckTraits<int32_t, true, true, true>());
+    static_assert(CheckTraits<Point, true, true, true>());
+    static_assert(CheckTraits<std::string, false, true, true>());
+    static_assert(CheckTraits<std::unique_ptr<int>, false, false, true>());
+    static_assert(CheckTraits<CopyOnly, false, true, true>());
+    static_assert(std::is_nothrow_move_constructible_v<task::Optional<std::string>>);
+
+    // An engaged optional is still a constant expression
+    constexpr task::Optional<int32_t> five(5);
+    static_assert(*five == 5);
+
+    task::Optional<Point> opt(Point{1, 2});
+    task::Optional<Point> copy;
+    std::memcpy(static_cast<void*>(&copy), &opt, sizeof(opt));
+    ASSERT_TRUE(copy.HasValue());
+    ASSERT_EQ(copy->y, 2);
+
+    task::Optional<std::unique_ptr<int>> ptr(std::make_unique<int>(5));
+    task::Optional<std::unique_ptr<int>> moved(std::move(ptr));
+    ASSERT_EQ(**moved, 5);
+    ptr = std::move(moved);
+    ASSERT_EQ(**ptr, 5);
+}
+
+struct Index {
+    uint32_t value;
+};
+
+template <>
+struct task::NicheTraits<Index> {
+    static constexpr bool kHasNiche = true;
+
+    static Index Empty() noexcept {
+        return Index{UINT32_MAX};
+    }
+
+    static bool IsEmpty(Index index) noexcept {
+        return index.value == UINT32_MAX;
+    }
+};
+
+struct Node {
+    int32_t value;
+};
+
+template <>
+struct task::NicheTraits<Node*> : task::PointerNicheTraits<Node> {};
+
+struct Ratio {
+    float value;
+};
+
+template <>
+struct task::NicheTraits<Ratio> : task::FloatNicheTraits<Ratio, uint32_t, 0x7fc0dead> {};
+
+TEST(Niche, Test1) {
+    static_assert(sizeof(task::Optional<Node*>) == sizeof(Node*));
+    static_assert(sizeof(task::Optional<Ratio>) == sizeof(Ratio));
+    static_assert(sizeof(task::Optional<Index>) == sizeof(Index));
+    static_assert(std::is_trivially_copyable_v<task::Optional<Index>>);
+
+    task::Optional<Node*> ptr;
+    ASSERT_FALSE(ptr.HasValue());
+    ptr = nullptr;
+    ASSERT_TRUE(ptr.HasValue());
+    ASSERT_EQ(*ptr, nullptr);
+    ptr.Reset();
+    ASSERT_FALSE(ptr);
+
+    task::Optional<Ratio> value(Ratio{std::nanf("")});
+    ASSERT_TRUE(value.HasValue());
+    value = task::kNullOpt;
+    ASSERT_FALSE(value.HasValue());
+    ASSERT_EQ(value.ValueOr(Ratio{1.5f}).value, 1.5f);
+
+    task::Optional<Index> index(Index{3});
+    ASSERT_EQ(index->value, 3u);
+    index.Reset();
+    ASSERT_FALSE(index.HasValue());
+    index = Index{0};
+    ASSERT_EQ(index.ValueOr(Index{7}).value, 0u);
+}
+
+TEST(Niche, Test2) {
+    // Without an opt-in every bit pattern is a value, MAP_FAILED and NaN payloads included
+    void* map_failed = reinterpret_cast<void*>(std::numeric_limits<uintptr_t>::max());
+    uint32_t float_bits = 0x7fc0dead;
+    uint64_t double_bits = 0x7ff8deaddeaddeadull;
+    float f = 0;
+    double d = 0;
+    std::memcpy(&f, &float_bits, sizeof(f));
+    std::memcpy(&d, &double_bits, sizeof(d));
+
+    ASSERT_TRUE(task::Optional<void*>(map_failed).HasValue());
+    ASSERT_TRUE(task::Optional<float>(f).HasValue());
+    ASSERT_TRUE(task::Optional<double>(d).HasValue());
+
+    // With one the sentinel is rejected and the optional stays disengaged
+    Node* sentinel = reinterpret_cast<Node*>(map_failed);
+    ASSERT_THROW(task::Optional<Node*>{sentinel}, std::invalid_argument);
+    ASSERT_THROW(task::Optional<Node*>(task::kInPlace, sentinel), std::invalid_argument);
+
+    task::Optional<Node*> ptr(nullptr);
+    ptr.Reset();
+    ASSERT_THROW(ptr = sentinel, std::invalid_argument);
+    ASSERT_FALSE(ptr.HasValue());
+
+    Ratio ratio{f};
+    ASSERT_THROW(task::Optional<Ratio>{ratio}, std::invalid_argument);
+    ASSERT_THROW(task::Optional<Index>(Index{UINT32_MAX}), std::invalid_argument);
+}
+
+TEST(Reference, Test1) {
+    static_assert(sizeof(task::Optional<std::string&>) == sizeof(std::string*));
+    static_assert(std::is_trivially_copyable_v<task::Optional<std::string&>>);
+    static_assert(!std::is_constructible_v<task::Optional<const std::string&>, std::string&&>);
+
+    std::string first = "Hello world";
+    std::string second = "Bye";
+
+    task::Optional<std::string&> ref;
+    ASSERT_FALSE(ref.HasValue());
+    ASSERT_EQ(ref.ValueOr("empty"), "empty");
+
+    ref = first;
+    ASSERT_TRUE(ref);
+    ref->append("!");
+    ASSERT_EQ(first, "Hello world!");
+
+    ref = second;
+    ASSERT_EQ(first, "Hello world!");
+    ASSERT_EQ(&*ref, &second);
+
+    task::Optional<std::string&> copy = ref;
+    ASSERT_EQ(&*copy, &second);
+    ASSERT_EQ(*copy.Transform([](const std::string& text) { return text.size(); }), 3u);
+
+    auto first_char = [](std::string& text) -> char& { return text[0]; };
+    task::Optional<char&> initial = copy.Transform(first_char);
+    *initial = 'b';
+    ASSERT_EQ(second, "bye");
+
+    ref.Reset();
+    ASSERT_FALSE(ref);
+}
+
 int main(int argc, char** argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
@@ -0,0 +1,108 @@
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "src/intrusive_ptr/intrusive_ptr.h"
+#include "src/shared_ptr/biased_shared_ptr.h"
+#include "src/shared_ptr/shared_ptr.h"
+
+// Copy and dereference cost of IntrusivePtr against SharedPtr, and of biased counting
+// against MakeShared while another thread copies the same pointer.
+// Not part of the test run. Take numbers from an optimized build, e.g. the benchmark
+// target with -DCMAKE_BUILD_TYPE=Release, or
+//   g++ -std=c++17 -O2 -I. benchmark.cpp -pthread -o benchmark
+
+namespace {
+
+constexpr int32_t kCopies = 20'000'000;
+constexpr int32_t kObjects = 1'000'000;
+constexpr int32_t kPasses = 20;
+
+struct Node : IntrusiveRefCounter<Node> {
+    int64_t value = 1;
+};
+
+template <typename F>
+double Milliseconds(F&& f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+        .count();
+}
+
+// One pointer copied and released over and over: the cost of the count updates
+template <typename Ptr>
+double CopyRelease(const Ptr& ptr) {
+    int64_t sum = 0;
+    double ms = Milliseconds([&] {
+        for (int32_t i = 0; i < kCopies; ++i) {
+            Ptr copy = ptr;
+            sum += copy->value;
+        }
+    });
+    return sum == kCopies ? ms : -1;
+}
+
+// The creating thread copies while another one copies its own copy of the same pointer:
+// with one atomic count every copy on either side moves the cache line
+template <typename Ptr>
+double SharedCopyRelease(const Ptr& ptr) {
+    std::atomic<bool> stop{false};
+    int64_t remote_sum = 0;
+    std::thread remote([&stop, &remote_sum, copy = ptr] {
+        while (!stop.load(std::memory_order_relaxed)) {
+            Ptr other = copy;
+            remote_sum += other->value;
+        }
+    });
+
+    double ms = CopyRelease(ptr);
+    stop = true;
+    remote.join();
+    return remote_sum > 0 ? ms : -1;
+}
+
+// Many pointers to distinct objects walked in order: the cost of reaching the object
+template <typename Ptr>
+double Dereference(const std::vector<Ptr>& ptrs) {
+    int64_t sum = 0;
+    double ms = Milliseconds([&] {
+        for (int32_t pass = 0; pass < kPasses; ++pass) {
+            for (const Ptr& ptr : ptrs) {
+                sum += ptr->value;
+            }
+        }
+    });
+    return sum == int64_t{kObjects} * kPasses ? ms : -1;
+}
+
+}  // namespace
+
+int main() {
+    std::cout << "copy + release x" << kCopies << " (ms)\n"
+              << "  SharedPtr(new)    " << CopyRelease(SharedPtr<Node>(new Node)) << "\n"
+              << "  MakeShared        " << CopyRelease(MakeShared<Node>()) << "\n"
+              << "  IntrusivePtr      " << CopyRelease(MakeIntrusive<Node>()) << "\n";
+
+    std::cout << "copy + release x" << kCopies << " with another thread copying (ms)\n"
+              << "  MakeShared        " << SharedCopyRelease(MakeShared<Node>()) << "\n"
+              << "  MakeSharedBiased  " << SharedCopyRelease(MakeSharedBiased<Node>()) << "\n";
+
+    std::vector<SharedPtr<Node>> separate;
+    std::vector<SharedPtr<Node>> inplace;
+    std::vector<IntrusivePtr<Node>> intrusive;
+    for (int32_t i = 0; i < kObjects; ++i) {
+        separate.emplace_back(new Node);
+        inplace.push_back(MakeShared<Node>());
+        intrusive.push_back(MakeIntrusive<Node>());
+    }
+
+    std::cout << "dereference " << kObjects << " pointers x" << kPasses << " (ms)\n"
+              << "  SharedPtr(new)    " << Dereference(separate) << "\n"
+              << "  MakeShared        " << Dereference(inplace) << "\n"
+              << "  IntrusivePtr      " << Dereference(intrusive) << "\n";
+    return 0;
+}
@@ -0,0 +1,189 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+#include "../shared_ptr/shared_ptr.h"
+
+// Snapshot published by AtomicSharedPtr.
+// Holds an ordinary SharedPtr, so aliasing and custom deleters survive publication.
+// pending_ balances the borrows handed over by the writer that unpublished the node
+// against the borrowers that gave them back, so it reaches zero exactly once
+// whichever side finishes last.
+template <typename T>
+class AtomicSharedPtrNode {
+public:
+    explicit AtomicSharedPtrNode(const SharedPtr<T>& value) : value_(value) {
+    }
+
+    void Retire(int64_t borrowed) noexcept {
+        if (pending_.fetch_add(borrowed) + borrowed == 0) {
+            delete this;
+        }
+    }
+
+    void ReleaseBorrowed() noexcept {
+        if (pending_.fetch_sub(1) == 1) {
+            delete this;
+        }
+    }
+
+    const SharedPtr<T>& Value() const noexcept {
+        return value_;
+    }
+
+private:
+    SharedPtr<T> value_;
+    std::atomic<int64_t> pending_{0};
+};
+
+// AtomicSharedPtr
+// Split reference count: the upper 16 bits of data_ count readers that borrowed the
+// node without touching any counter, the lower 48 bits hold the node address.
+template <typename T>
+class AtomicSharedPtr {
+public:
+    constexpr AtomicSharedPtr() noexcept = default;
+    explicit AtomicSharedPtr(const SharedPtr<T>& desired);
+    ~AtomicSharedPtr();
+
+    AtomicSharedPtr(const AtomicSharedPtr&) = delete;
+    AtomicSharedPtr& operator=(const AtomicSharedPtr&) = delete;
+
+    SharedPtr<T> Load() const;
+    void Store(const SharedPtr<T>& desired);
+    SharedPtr<T> Exchange(const SharedPtr<T>& desired);
+    bool CompareExchange(SharedPtr<T>& expected, const SharedPtr<T>& desired);
+
+    bool IsLockFree() const noexcept;
+
+private:
+    using node_type = AtomicSharedPtrNode<T>;
+
+    static constexpr int kCountShift = 48;
+    static constexpr uintptr_t kCountOne = uintptr_t{1} << kCountShift;
+    static constexpr uintptr_t kPtrMask = kCountOne - 1;
+
+    static_assert(sizeof(uintptr_t) == 8, "AtomicSharedPtr requires 64-bit pointers");
+
+    static node_type* NodeOf(uintptr_t data) noexcept;
+    static uintptr_t Pack(node_type* node) noexcept;
+    static node_type* MakeNode(const SharedPtr<T>& value);
+
+    // Pins the current node by bumping the borrowed count stored next to it
+    uintptr_t Borrow() const noexcept;
+    void GiveBack(node_type* node) const noexcept;
+    // Hands the borrows still recorded in old_data over to the unpublished node
+    static void RetireNode(uintptr_t old_data) noexcept;
+
+    mutable std::atomic<uintptr_t> data_{0};
+};
+
+template <typename T>
+AtomicSharedPtr<T>::AtomicSharedPtr(const SharedPtr<T>& desired) : data_(Pack(MakeNode(desired))) {
+}
+
+template <typename T>
+AtomicSharedPtr<T>::~AtomicSharedPtr() {
+    RetireNode(data_.exchange(0));
+}
+
+template <typename T>
+typename AtomicSharedPtr<T>::node_type* AtomicSharedPtr<T>::NodeOf(uintptr_t data) noexcept {
+    return reinterpret_cast<node_type*>(data & kPtrMask);
+}
+
+template <typename T>
+uintptr_t AtomicSharedPtr<T>::Pack(node_type* node) noexcept {
+    return reinterpret_cast<uintptr_t>(node);
+}
+
+template <typename T>
+typename AtomicSharedPtr<T>::node_type* AtomicSharedPtr<T>::MakeNode(const SharedPtr<T>& value) {
+    return value ? new node_type(value) : nullptr;
+}
+
+template <typename T>
+uintptr_t AtomicSharedPtr<T>::Borrow() const noexcept {
+    return data_.fetch_add(kCountOne) + kCountOne;
+}
+
+template <typename T>
+void AtomicSharedPtr<T>::GiveBack(node_type* node) const noexcept {
+    uintptr_t data = data_.load();
+    while (NodeOf(data) == node) {
+        if (data_.compare_exchange_weak(data, data - kCountOne)) {
+            return;
+        }
+    }
+
+    // A writer replaced the node and took our borrow along with it
+    if (node != nullptr) {
+        node->ReleaseBorrowed();
+    }
+}
+
+template <typename T>
+void AtomicSharedPtr<T>::RetireNode(uintptr_t old_data) noexcept {
+    node_type* node = NodeOf(old_data);
+    if (node != nullptr) {
+        node->Retire(static_cast<int64_t>(old_data >> kCountShift));
+    }
+}
+
+template <typename T>
+SharedPtr<T> AtomicSharedPtr<T>::Load() const {
+    node_type* node = NodeOf(Borrow());
+    SharedPtr<T> res = node == nullptr ? SharedPtr<T>() : node->Value();
+    GiveBack(node);
+    return res;
+}
+
+template <typename T>
+void AtomicSharedPtr<T>::Store(const SharedPtr<T>& desired) {
+    RetireNode(data_.exchange(Pack(MakeNode(desired))));
+}
+
+template <typename T>
+SharedPtr<T> AtomicSharedPtr<T>::Exchange(const SharedPtr<T>& desired) {
+    uintptr_t old_data = data_.exchange(Pack(MakeNode(desired)));
+    node_type* old_node = NodeOf(old_data);
+    SharedPtr<T> res = old_node == nullptr ? SharedPtr<T>() : old_node->Value();
+    RetireNode(old_data);
+    return res;
+}
+
+template <typename T>
+bool AtomicSharedPtr<T>::CompareExchange(SharedPtr<T>& expected, const SharedPtr<T>& desired) {
+    node_type* new_node = MakeNode(desired);
+
+    while (true) {
+        uintptr_t data = Borrow();
+        node_type* node = NodeOf(data);
+        SharedPtr<T> current = node == nullptr ? SharedPtr<T>() : node->Value();
+
+        if (current.Get() != expected.Get() || current.control_block_ != expected.control_block_) {
+            GiveBack(node);
+            delete new_node;
+            expected = current;
+            return false;
+        }
+
+        while (NodeOf(data) == node) {
+            if (data_.compare_exchange_weak(data, Pack(new_node))) {
+                RetireNode(data);
+                GiveBack(node);
+                return true;
+            }
+        }
+
+        // Another writer won the race: re-read the value and compare again
+        GiveBack(node);
+    }
+}
+
+template <typename T>
+bool AtomicSharedPtr<T>::IsLockFree() const noexcept {
+    return data_.is_lock_free();
+}
+// AtomicSharedPtr
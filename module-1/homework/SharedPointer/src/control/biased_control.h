@@ -0,0 +1,372 @@
+#pragma once
+
+#ifdef __linux__
+#include <linux/membarrier.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <atomic>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "control.h"
+
+// Biased reference counting (Choi, Shull, Torrellas, "Biased Reference Counting", PACT'18).
+// The thread that created a block counts its references in a plain local counter; every
+// other thread uses the atomic state_. The two are merged into state_ once the owner's
+// local count drops to zero, or when another thread drives state_ negative by releasing
+// references the owner handed out: the block is queued to the owner, and whichever side
+// sees local_ + state_ reach zero first merges it, so an idle owner never keeps it alive.
+
+// AsymmetricFence - the owner's release path pairs with the rare remote release that
+// drives state_ negative. The owner only stops the compiler from reordering, the remote
+// side makes every running thread execute a full barrier with membarrier(2); where that
+// is unavailable both sides fall back to a full fence.
+class AsymmetricFence {
+public:
+    // Registers the process on first use, i.e. when the first biased block is created
+    static bool Expedited() noexcept {
+        static const bool kExpedited = Register();
+        return kExpedited;
+    }
+
+    static void Light() noexcept {
+        if (Expedited()) {
+            std::atomic_signal_fence(std::memory_order_seq_cst);
+        } else {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+        }
+    }
+
+    static void Heavy() noexcept {
+#ifdef __linux__
+        if (Expedited()) {
+            syscall(SYS_membarrier, MEMBARRIER_CMD_PRIVATE_EXPEDITED, 0, 0);
+            return;
+        }
+#endif
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+
+private:
+    static bool Register() noexcept {
+#ifdef __linux__
+        return syscall(SYS_membarrier, MEMBARRIER_CMD_REGISTER_PRIVATE_EXPEDITED, 0, 0) == 0;
+#else
+        return false;
+#endif
+    }
+};
+
+class BiasedControlBlockBase;
+
+// BiasedQueue - blocks waiting for their owner thread to merge the local count
+class BiasedQueue {
+public:
+    // Queue of the calling thread, created the first time the thread owns a biased block
+    static BiasedQueue* Current();
+
+    static bool IsCurrent(const BiasedQueue* queue) noexcept {
+        return queue == current_;
+    }
+
+    void AddRef() noexcept {
+        ++refs_;
+    }
+
+    void Release() noexcept {
+        if (--refs_ == 0) {
+            delete this;
+        }
+    }
+
+    bool HasPending() const noexcept {
+        return head_.load(std::memory_order_relaxed) != nullptr;
+    }
+
+    // Returns false once the owner thread has exited.
+    // A queued block holds a weak reference, so it outlives a merge done by another thread
+    bool Push(BiasedControlBlockBase* block) noexcept;
+
+    // Called by the owner thread only
+    void Drain() noexcept;
+
+private:
+    struct ThreadHolder {
+        ThreadHolder();
+        ~ThreadHolder();
+
+        BiasedQueue* queue;
+    };
+
+    static BiasedControlBlockBase* ClosedMark() noexcept {
+        return reinterpret_cast<BiasedControlBlockBase*>(uintptr_t{1});
+    }
+
+    static void DrainList(BiasedControlBlockBase* list) noexcept;
+
+    inline static thread_local BiasedQueue* current_ = nullptr;
+
+    std::atomic<BiasedControlBlockBase*> head_{nullptr};
+    std::atomic<uint32_t> refs_{1};
+};
+// BiasedQueue
+
+class BiasedControlBlockBase : public SharedWeakCount {
+public:
+    BiasedControlBlockBase() : owner_(BiasedQueue::Current()) {
+        AsymmetricFence::Expedited();
+        sharedCount = kBiased;
+        owner_->AddRef();
+    }
+
+    ~BiasedControlBlockBase() override {
+        owner_->Release();
+    }
+
+    friend class BiasedQueue;
+
+protected:
+    void AddSharedBiased() noexcept override;
+    bool AddSharedIfNotZeroBiased() noexcept override;
+    bool ReleaseSharedBiased() noexcept override;
+    size_t GetSharedBiased() noexcept override;
+
+private:
+    // state_ = count * kOne + flags; count may go negative before the merge
+    static constexpr int64_t kMerged = 1;
+    static constexpr int64_t kQueued = 2;
+    static constexpr int64_t kOne = 4;
+
+    static int64_t CountOf(int64_t state) noexcept {
+        return (state - (state & (kOne - 1))) / kOne;
+    }
+
+    bool IsOwner() const noexcept {
+        return BiasedQueue::IsCurrent(owner_) && !merged_;
+    }
+
+    // Folds local_ into state_ on the owner thread, or after it has exited;
+    // returns false if no owners are left
+    bool Merge() noexcept;
+
+    // Called by another thread that left state_ negative: merges only if local_ + state_
+    // is zero, i.e. nobody holds the block any more; returns false if it merged
+    bool MergeIfUnowned() noexcept;
+
+    bool ReleaseSharedRemote() noexcept;
+
+    void Destroy() noexcept {
+        OnZeroShared();
+        ReleaseWeak();
+    }
+
+    BiasedQueue* owner_;
+    // Written by the owner thread only; atomic so that other threads may read it
+    std::atomic<uint32_t> local_{1};
+    bool merged_ = false;
+    std::atomic<int64_t> state_{0};
+    BiasedControlBlockBase* next_ = nullptr;
+};
+
+// Object is constructed inside the block, as with InplaceControlBlock
+template <typename T>
+class BiasedControlBlock : public BiasedControlBlockBase {
+public:
+    template <typename... Args>
+    explicit BiasedControlBlock(Args&&... args) {
+        ::new (static_cast<void*>(&storage_)) T(std::forward<Args>(args)...);
+    }
+
+    BiasedControlBlock(BiasedControlBlock&) = delete;
+
+    void operator=(BiasedControlBlock&) = delete;
+
+    T* Get() noexcept {
+        return std::launder(reinterpret_cast<T*>(&storage_));
+    }
+
+    void OnZeroShared() noexcept override {
+        Get()->~T();
+    }
+
+private:
+    std::aligned_storage_t<sizeof(T), alignof(T)> storage_;
+};
+
+// BiasedQueue
+inline BiasedQueue* BiasedQueue::Current() {
+    if (current_ == nullptr) {
+        static thread_local ThreadHolder holder;
+        current_ = holder.queue;
+    }
+    return current_;
+}
+
+inline BiasedQueue::ThreadHolder::ThreadHolder() : queue(new BiasedQueue()) {
+}
+
+inline BiasedQueue::ThreadHolder::~ThreadHolder() {
+    current_ = nullptr;
+    DrainList(queue->head_.exchange(ClosedMark()));
+    queue->Release();
+}
+
+inline bool BiasedQueue::Push(BiasedControlBlockBase* block) noexcept {
+    BiasedControlBlockBase* head = head_.load();
+    do {
+        if (head == ClosedMark()) {
+            return false;
+        }
+        block->next_ = head;
+    } while (!head_.compare_exchange_weak(head, block));
+
+    return true;
+}
+
+inline void BiasedQueue::Drain() noexcept {
+    DrainList(head_.exchange(nullptr));
+}
+
+inline void BiasedQueue::DrainList(BiasedControlBlockBase* list) noexcept {
+    while (list != nullptr) {
+        BiasedControlBlockBase* next = list->next_;
+        if (!list->merged_ && !list->Merge()) {
+            list->Destroy();
+        }
+        list->ReleaseWeak();
+        list = next;
+    }
+}
+// BiasedQueue
+
+// BiasedControlBlockBase
+inline bool BiasedControlBlockBase::Merge() noexcept {
+    int64_t local = local_.load(std::memory_order_relaxed);
+    int64_t state = state_.load();
+    int64_t desired = 0;
+    do {
+        // Merged by another thread that saw nobody holding the block; it destroys it
+        if ((state & kMerged) != 0) {
+            merged_ = true;
+            return true;
+        }
+        desired = (state + local * kOne) | kMerged;
+    } while (!state_.compare_exchange_weak(state, desired));
+
+    local_.store(0, std::memory_order_relaxed);
+    merged_ = true;
+    return CountOf(desired) != 0;
+}
+
+inline bool BiasedControlBlockBase::MergeIfUnowned() noexcept {
+    // Either this reads the owner's last store to local_, or the owner sees kQueued
+    AsymmetricFence::Heavy();
+    int64_t local = local_.load(std::memory_order_relaxed);
+
+    int64_t state = state_.load();
+    do {
+        if ((state & kMerged) != 0 || CountOf(state) + local != 0) {
+            return true;
+        }
+    } while (!state_.compare_exchange_weak(state, (state + local * kOne) | kMerged));
+
+    return false;
+}
+
+inline void BiasedControlBlockBase::AddSharedBiased() noexcept {
+    if (IsOwner()) {
+        local_.store(local_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        return;
+    }
+    state_ += kOne;
+}
+
+inline bool BiasedControlBlockBase::AddSharedIfNotZeroBiased() noexcept {
+    // Until the merge nothing has been destroyed, so any count may be revived
+    int64_t state = state_.load();
+    while ((state & kMerged) == 0 || CountOf(state) != 0) {
+        if (state_.compare_exchange_weak(state, state + kOne)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+inline bool BiasedControlBlockBase::ReleaseSharedBiased() noexcept {
+    if (BiasedQueue::IsCurrent(owner_) && owner_->HasPending()) {
+        // We still hold a reference, so draining cannot destroy this block
+        owner_->Drain();
+    }
+
+    if (IsOwner()) {
+        uint32_t local = local_.load(std::memory_order_relaxed) - 1;
+        local_.store(local, std::memory_order_relaxed);
+        if (local == 0) {
+            return Merge();
+        }
+
+        // Another thread may have released the last reference handed out meanwhile
+        AsymmetricFence::Light();
+        return (state_.load(std::memory_order_relaxed) & kQueued) == 0 || Merge();
+    }
+
+    int64_t state = state_.load();
+    if ((state & kMerged) != 0) {
+        int64_t desired = state_ -= kOne;
+        return CountOf(desired) != 0;
+    }
+
+    // The owner may merge and destroy the block while we look at it
+    AddWeak();
+    bool alive = ReleaseSharedRemote();
+    ReleaseWeak();
+    return alive;
+}
+
+inline bool BiasedControlBlockBase::ReleaseSharedRemote() noexcept {
+    int64_t state = state_.load();
+    int64_t desired = 0;
+    do {
+        desired = state - kOne;
+        if ((desired & kMerged) == 0 && CountOf(desired) < 0) {
+            desired |= kQueued;
+        }
+    } while (!state_.compare_exchange_weak(state, desired));
+
+    if ((desired & kMerged) != 0) {
+        return CountOf(desired) != 0;
+    }
+    if (CountOf(desired) >= 0) {
+        return true;
+    }
+
+    // The first release that went below zero hands the block to its owner;
+    // once the owner has exited local_ is frozen and we can merge it ourselves
+    if ((state & kQueued) == 0) {
+        AddWeak();
+        if (!owner_->Push(this)) {
+            ReleaseWeak();
+            return Merge();
+        }
+    }
+
+    return MergeIfUnowned();
+}
+
+inline size_t BiasedControlBlockBase::GetSharedBiased() noexcept {
+    int64_t state = state_.load();
+    int64_t count = CountOf(state);
+    if ((state & kMerged) != 0) {
+        return count;
+    }
+
+    // Not merged yet means not destroyed yet
+    count += local_.load(std::memory_order_relaxed);
+    return count > 0 ? count : 1;
+}
+// BiasedControlBlockBase
@@ -1,22 +1,54 @@
 #pragma once
 
 #include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
 
+// Counts are 32-bit: together with the vtable pointer both of them fit in 16 bytes,
+// leaving ControlBlock at 24 bytes for a pointer with a stateless deleter
 class SharedCount {
 public:
+    using count_type = uint32_t;
+
     SharedCount() = default;
 
-    explicit SharedCount(size_t count) noexcept : sharedCount(count) {
+    explicit SharedCount(count_type count) noexcept : sharedCount(count) {
     }
 
     virtual ~SharedCount() = default;
 
     void AddShared() noexcept {
-        ++sharedCount;
+        if (IsBiased()) {
+            AddSharedBiased();
+            return;
+        }
+        [[maybe_unused]] count_type previous = sharedCount++;
+        assert(previous + 1 < kBiased);
+    }
+
+    // Increments the count only if the object is still alive
+    bool AddSharedIfNotZero() noexcept {
+        if (IsBiased()) {
+            return AddSharedIfNotZeroBiased();
+        }
+
+        count_type count = sharedCount.load();
+        while (count != 0) {
+            assert(count + 1 < kBiased);
+            if (sharedCount.compare_exchange_weak(count, count + 1)) {
+                return true;
+            }
+        }
+
+        return false;
     }
 
     bool ReleaseShared() noexcept {
-        if (--sharedCount == 0) {
+        if (IsBiased() ? !ReleaseSharedBiased() : --sharedCount == 0) {
             OnZeroShared();
             return false;
         }
@@ -25,56 +57,216 @@ public:
     }
 
     size_t GetShared() {
-        return sharedCount;
+        return IsBiased() ? GetSharedBiased() : sharedCount.load();
     }
 
     virtual void OnZeroShared() noexcept = 0;
 
 protected:
-    std::atomic<size_t> sharedCount{0};
+    // Biased blocks (see biased_control.h) keep this flag in sharedCount for their whole
+    // life and count through the hooks below; for all other blocks the check is one
+    // well-predicted branch on a line the following atomic touches anyway. A separate
+    // flag would not fit into 24 bytes, so other blocks are limited to 2^31 - 1 owners
+    static constexpr count_type kBiased = count_type{1} << 31;
+
+    bool IsBiased() const noexcept {
+        return (sharedCount.load(std::memory_order_relaxed) & kBiased) != 0;
+    }
+
+    virtual void AddSharedBiased() noexcept {
+    }
+
+    virtual bool AddSharedIfNotZeroBiased() noexcept {
+        return false;
+    }
+
+    // Returns false when the last owner is gone
+    virtual bool ReleaseSharedBiased() noexcept {
+        return true;
+    }
+
+    virtual size_t GetSharedBiased() noexcept {
+        return 0;
+    }
+
+    std::atomic<count_type> sharedCount{0};
 };
 
+// All shared owners together hold one weak reference,
+// so the block is deleted once both the object and the last WeakPtr are gone
 class SharedWeakCount : public SharedCount {
 public:
     SharedWeakCount() = default;
 
     virtual ~SharedWeakCount() = default;
 
+    bool ReleaseShared() noexcept {
+        if (!SharedCount::ReleaseShared()) {
+            ReleaseWeak();
+            return false;
+        }
+
+        return true;
+    }
+
     void AddWeak() noexcept {
         ++weakCount;
     }
 
     void ReleaseWeak() noexcept {
-        --weakCount;
+        if (--weakCount == 0) {
+            delete this;
+        }
     }
 
     size_t GetWeak() {
-        return weakCount;
+        return weakCount - (GetShared() == 0 ? 0 : 1);
     }
 
 protected:
-    std::atomic<size_t> weakCount{0};
+    std::atomic<count_type> weakCount{1};
+};
+
+// DeleterStorage - empty deleters are kept as a base to take no space
+template <typename Deleter, bool = std::is_empty_v<Deleter> && !std::is_final_v<Deleter>>
+class DeleterStorage {
+public:
+    DeleterStorage() = default;
+
+    explicit DeleterStorage(const Deleter& deleter) : deleter_(deleter) {
+    }
+
+    Deleter& GetDeleter() noexcept {
+        return deleter_;
+    }
+
+private:
+    Deleter deleter_;
+};
+
+template <typename Deleter>
+class DeleterStorage<Deleter, true> : private Deleter {
+public:
+    DeleterStorage() = default;
+
+    explicit DeleterStorage(const Deleter& deleter) : Deleter(deleter) {
+    }
+
+    Deleter& GetDeleter() noexcept {
+        return *this;
+    }
 };
+// DeleterStorage
 
 template <typename T, typename Deleter = std::default_delete<std::remove_pointer_t<T>>>
-class ControlBlock : public SharedWeakCount {
+class ControlBlock : public SharedWeakCount, private DeleterStorage<Deleter> {
 public:
     ControlBlock() = default;
 
-    explicit ControlBlock(T& object)
-        : object_(object), deleter_(std::default_delete<std::remove_pointer_t<T>>()){};
+    explicit ControlBlock(T& object) : object_(object){};
 
-    ControlBlock(T& object, Deleter& deleter) : object_(object), deleter_(deleter){};
+    ControlBlock(T& object, Deleter& deleter) : DeleterStorage<Deleter>(deleter), object_(object){};
 
     ControlBlock(ControlBlock&) = delete;
 
     void operator=(ControlBlock&) = delete;
 
     void OnZeroShared() noexcept override {
-        deleter_(object_);
+        this->GetDeleter()(object_);
     }
 
 private:
     T object_;
-    Deleter deleter_;
-};
\ No newline at end of file
+};
+
+// Used by MakeShared: the object lives inside the block, so both need one allocation
+template <typename T>
+class InplaceControlBlock : public SharedWeakCount {
+public:
+    template <typename... Args>
+    explicit InplaceControlBlock(Args&&... args) {
+        ::new (static_cast<void*>(&storage_)) T(std::forward<Args>(args)...);
+    }
+
+    InplaceControlBlock(InplaceControlBlock&) = delete;
+
+    void operator=(InplaceControlBlock&) = delete;
+
+    T* Get() noexcept {
+        return std::launder(reinterpret_cast<T*>(&storage_));
+    }
+
+    void OnZeroShared() noexcept override {
+        Get()->~T();
+    }
+
+private:
+    std::aligned_storage_t<sizeof(T), alignof(T)> storage_;
+};
+
+// Used by MakeShared<T[]>: the elements follow the block in the same allocation
+template <typename T>
+class InplaceArrayControlBlock : public SharedWeakCount {
+public:
+    static InplaceArrayControlBlock* Create(size_t size);
+
+    InplaceArrayControlBlock(InplaceArrayControlBlock&) = delete;
+
+    void operator=(InplaceArrayControlBlock&) = delete;
+
+    // The memory comes from ::operator new in Create, so delete this must return it there
+    static void operator delete(void* p) {
+        ::operator delete(p);
+    }
+
+    T* Get() noexcept {
+        return std::launder(reinterpret_cast<T*>(reinterpret_cast<char*>(this) + HeaderSize()));
+    }
+
+    void OnZeroShared() noexcept override {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            DestroyElements(size_);
+        }
+    }
+
+private:
+    static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__,
+                  "over-aligned array elements are not supported");
+
+    explicit InplaceArrayControlBlock(size_t size) : size_(size) {
+    }
+
+    static constexpr size_t HeaderSize() {
+        return (sizeof(InplaceArrayControlBlock) + alignof(T) - 1) / alignof(T) * alignof(T);
+    }
+
+    void DestroyElements(size_t count) noexcept {
+        T* elements = Get();
+        for (; count > 0; --count) {
+            elements[count - 1].~T();
+        }
+    }
+
+    size_t size_;
+};
+
+template <typename T>
+InplaceArrayControlBlock<T>* InplaceArrayControlBlock<T>::Create(size_t size) {
+    void* raw = ::operator new(HeaderSize() + size * sizeof(T));
+    auto* block = ::new (raw) InplaceArrayControlBlock(size);
+
+    T* elements = block->Get();
+    size_t constructed = 0;
+    try {
+        for (; constructed < size; ++constructed) {
+            ::new (static_cast<void*>(elements + constructed)) T();
+        }
+    } catch (...) {
+        block->DestroyElements(constructed);
+        block->~InplaceArrayControlBlock();
+        ::operator delete(raw);
+        throw;
+    }
+
+    return block;
+}
@@ -0,0 +1,172 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include "control.h"
+
+// Deferred destruction: when the last owner of a deferred block goes away, the block
+// is pushed onto a lock-free list and the object is destroyed on a background thread,
+// so an expensive destructor never runs on a latency-critical thread.
+
+class ReclaimNode {
+public:
+    virtual ~ReclaimNode() = default;
+
+    // Destroys the object on the reclaimer thread
+    virtual void Reclaim() noexcept = 0;
+
+private:
+    friend class Reclaimer;
+
+    ReclaimNode* next_ = nullptr;
+};
+
+// Reclaimer
+class Reclaimer {
+public:
+    // Never destroyed, so a deferred block may be released at any point of the exit.
+    // The background thread is stopped by an atexit handler after it reclaims everything
+    // queued so far; blocks released later, e.g. by statics constructed before the first
+    // MakeSharedDeferred, are reclaimed on the releasing thread
+    static Reclaimer& Instance();
+
+    Reclaimer(const Reclaimer&) = delete;
+    Reclaimer& operator=(const Reclaimer&) = delete;
+
+    void Push(ReclaimNode* node) noexcept;
+
+    // Blocks until everything pushed before the call has been reclaimed
+    void Flush();
+
+private:
+    Reclaimer();
+
+    void Run();
+
+    void Stop();
+
+    // Reclaims the nodes taken from head_ on the calling thread
+    void ReclaimList(ReclaimNode* list) noexcept;
+
+    std::atomic<ReclaimNode*> head_{nullptr};
+    std::atomic<uint64_t> pushed_{0};
+    uint64_t reclaimed_ = 0;
+    std::atomic<bool> stop_{false};
+
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    std::thread thread_;
+};
+
+inline Reclaimer& Reclaimer::Instance() {
+    static Reclaimer* instance = new Reclaimer();
+    return *instance;
+}
+
+inline Reclaimer::Reclaimer() : thread_([this] { Run(); }) {
+    std::atexit([] { Instance().Stop(); });
+}
+
+inline void Reclaimer::Stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    wake_.notify_one();
+    thread_.join();
+
+    // A push that raced with the thread's last pass
+    ReclaimList(head_.exchange(nullptr));
+}
+
+inline void Reclaimer::Push(ReclaimNode* node) noexcept {
+    ++pushed_;
+    if (stop_) {
+        node->next_ = nullptr;
+        ReclaimList(node);
+        return;
+    }
+
+    ReclaimNode* head = head_.load();
+    do {
+        node->next_ = head;
+    } while (!head_.compare_exchange_weak(head, node));
+
+    // Either Stop sees the node or we see stop_
+    if (stop_) {
+        ReclaimList(head_.exchange(nullptr));
+        return;
+    }
+
+    // Only the push that makes the list non-empty has to wake the thread up
+    if (head == nullptr) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+        }
+        wake_.notify_one();
+    }
+}
+
+inline void Reclaimer::Flush() {
+    uint64_t target = pushed_.load();
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [this, target] { return reclaimed_ >= target; });
+}
+
+inline void Reclaimer::Run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        wake_.wait(lock, [this] { return stop_ || head_.load() != nullptr; });
+        lock.unlock();
+        ReclaimList(head_.exchange(nullptr));
+        lock.lock();
+
+        if (stop_ && head_.load() == nullptr) {
+            return;
+        }
+    }
+}
+
+inline void Reclaimer::ReclaimList(ReclaimNode* list) noexcept {
+    uint64_t count = 0;
+    while (list != nullptr) {
+        ReclaimNode* next = list->next_;
+        list->Reclaim();
+        list = next;
+        ++count;
+    }
+
+    if (count != 0) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        reclaimed_ += count;
+        done_.notify_all();
+    }
+}
+// Reclaimer
+
+// Wraps any control block whose OnZeroShared destroys the object.
+// The block takes an extra weak reference while it is queued, so it outlives the list.
+template <typename Block>
+class DeferredControlBlock : public Block, public ReclaimNode {
+public:
+    template <typename... Args>
+    explicit DeferredControlBlock(Args&&... args) : Block(std::forward<Args>(args)...) {
+    }
+
+    void OnZeroShared() noexcept override {
+        this->AddWeak();
+        Reclaimer::Instance().Push(this);
+    }
+
+    void Reclaim() noexcept override {
+        Block::OnZeroShared();
+        this->ReleaseWeak();
+    }
+};
@@ -0,0 +1,187 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <utility>
+
+// IntrusiveRefCounter
+// CRTP base that keeps the reference count inside the object itself.
+// Same counting rules as SharedCount, but without a vtable or a separate control block:
+// the object is deleted as Derived when the last IntrusivePtr lets go.
+template <typename Derived>
+class IntrusiveRefCounter {
+public:
+    void AddShared() const noexcept {
+        ++sharedCount;
+    }
+
+    bool ReleaseShared() const noexcept {
+        if (--sharedCount == 0) {
+            delete static_cast<const Derived*>(this);
+            return false;
+        }
+
+        return true;
+    }
+
+    size_t GetShared() const noexcept {
+        return sharedCount;
+    }
+
+protected:
+    IntrusiveRefCounter() = default;
+
+    // Copies of the object are new objects with no owners yet
+    IntrusiveRefCounter(const IntrusiveRefCounter&) noexcept {
+    }
+
+    IntrusiveRefCounter& operator=(const IntrusiveRefCounter&) noexcept {
+        return *this;
+    }
+
+    ~IntrusiveRefCounter() = default;
+
+private:
+    mutable std::atomic<uint32_t> sharedCount{0};
+};
+// IntrusiveRefCounter
+
+// IntrusivePtr
+template <typename T>
+class IntrusivePtr {
+public:
+    using element_type = T;
+
+    constexpr IntrusivePtr() noexcept = default;
+    ~IntrusivePtr();
+
+    explicit IntrusivePtr(T* p, bool add_ref = true) noexcept;
+
+    IntrusivePtr(const IntrusivePtr& other) noexcept;
+    IntrusivePtr(IntrusivePtr&& other) noexcept;
+
+    template <typename Y>
+    IntrusivePtr(const IntrusivePtr<Y>& other) noexcept;  // NOLINT
+
+    IntrusivePtr& operator=(const IntrusivePtr& r) noexcept;
+    IntrusivePtr& operator=(IntrusivePtr&& r) noexcept;
+
+    // Modifiers
+    void Reset() noexcept;
+    void Reset(T* p) noexcept;
+    void Swap(IntrusivePtr& other) noexcept;
+
+    // Gives up ownership without releasing the reference
+    T* Detach() noexcept;
+
+    // Observers
+    T* Get() const noexcept;
+    int64_t UseCount() const noexcept;
+    T& operator*() const noexcept;
+    T* operator->() const noexcept;
+    explicit operator bool() const noexcept;
+
+private:
+    T* ptr_ = nullptr;
+};
+
+// MakeIntrusive
+template <typename T, typename... Args>
+IntrusivePtr<T> MakeIntrusive(Args&&... args) {
+    return IntrusivePtr<T>(new T(std::forward<Args>(args)...));
+}
+// MakeIntrusive
+
+template <typename T>
+IntrusivePtr<T>::~IntrusivePtr() {
+    if (ptr_ != nullptr) {
+        ptr_->ReleaseShared();
+    }
+}
+
+template <typename T>
+IntrusivePtr<T>::IntrusivePtr(T* p, bool add_ref) noexcept : ptr_(p) {
+    if (ptr_ != nullptr && add_ref) {
+        ptr_->AddShared();
+    }
+}
+
+template <typename T>
+IntrusivePtr<T>::IntrusivePtr(const IntrusivePtr& other) noexcept : ptr_(other.ptr_) {
+    if (ptr_ != nullptr) {
+        ptr_->AddShared();
+    }
+}
+
+template <typename T>
+IntrusivePtr<T>::IntrusivePtr(IntrusivePtr&& other) noexcept : ptr_(other.ptr_) {
+    other.ptr_ = nullptr;
+}
+
+template <typename T>
+template <typename Y>
+IntrusivePtr<T>::IntrusivePtr(const IntrusivePtr<Y>& other) noexcept : ptr_(other.Get()) {
+    if (ptr_ != nullptr) {
+        ptr_->AddShared();
+    }
+}
+
+template <typename T>
+IntrusivePtr<T>& IntrusivePtr<T>::operator=(const IntrusivePtr& r) noexcept {
+    IntrusivePtr<T>(r).Swap(*this);
+    return *this;
+}
+
+template <typename T>
+IntrusivePtr<T>& IntrusivePtr<T>::operator=(IntrusivePtr&& r) noexcept {
+    IntrusivePtr<T>(std::move(r)).Swap(*this);
+    return *this;
+}
+
+template <typename T>
+void IntrusivePtr<T>::Reset() noexcept {
+    IntrusivePtr<T>().Swap(*this);
+}
+
+template <typename T>
+void IntrusivePtr<T>::Reset(T* p) noexcept {
+    IntrusivePtr<T>(p).Swap(*this);
+}
+
+template <typename T>
+void IntrusivePtr<T>::Swap(IntrusivePtr& other) noexcept {
+    std::swap(ptr_, other.ptr_);
+}
+
+template <typename T>
+T* IntrusivePtr<T>::Detach() noexcept {
+    T* res = ptr_;
+    ptr_ = nullptr;
+    return res;
+}
+
+template <typename T>
+T* IntrusivePtr<T>::Get() const noexcept {
+    return ptr_;
+}
+
+template <typename T>
+int64_t IntrusivePtr<T>::UseCount() const noexcept {
+    return ptr_ == nullptr ? 0 : ptr_->GetShared();
+}
+
+template <typename T>
+T& IntrusivePtr<T>::operator*() const noexcept {
+    return *ptr_;
+}
+
+template <typename T>
+T* IntrusivePtr<T>::operator->() const noexcept {
+    return ptr_;
+}
+
+template <typename T>
+IntrusivePtr<T>::operator bool() const noexcept {
+    return ptr_ != nullptr;
+}
+// IntrusivePtr
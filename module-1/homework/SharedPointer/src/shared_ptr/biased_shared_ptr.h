@@ -0,0 +1,11 @@
+#pragma once
+
+#include "../control/biased_control.h"
+#include "shared_ptr.h"
+
+// Copies made by the calling thread skip atomic operations, see biased_control.h.
+// Kept apart so that plain SharedPtr users do not pull in the membarrier machinery
+template <typename T, typename... Args>
+SharedPtr<T> MakeSharedBiased(Args&&... args) {
+    return SharedPtr<T>::FromInplace(new BiasedControlBlock<T>(std::forward<Args>(args)...));
+}
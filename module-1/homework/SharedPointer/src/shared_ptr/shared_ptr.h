@@ -1,15 +1,28 @@
 #pragma once
 
 #include "../control/control.h"
+#include "../control/deferred_control.h"
 
 // SharedPtr
 template <typename T>
 class WeakPtr;
 
+template <typename T>
+class AtomicSharedPtr;
+
+template <typename T>
+class EnableSharedFromThis;
+
+// Y* is compatible with T* as for std::shared_ptr: Derived to Base and U[] to const U[],
+// but never Derived[] to Base[], which could not be indexed
+template <typename Y, typename T>
+using enable_if_compatible_t = std::enable_if_t<std::is_convertible_v<Y*, T*>>;
+
+// SharedPtr<T[]> owns an array: it deletes with delete[] and offers operator[]
 template <typename T>
 class SharedPtr {
 public:
-    using element_type = T;
+    using element_type = std::remove_extent_t<T>;
 
     constexpr SharedPtr() noexcept = default;
     ~SharedPtr();
@@ -23,14 +36,27 @@ public:
     SharedPtr(const SharedPtr& other) noexcept;
     SharedPtr(SharedPtr&& other) noexcept;
 
-    SharedPtr& operator=(const SharedPtr& r) noexcept;
+    template <typename Y, typename = enable_if_compatible_t<Y, T>>
+    SharedPtr(const SharedPtr<Y>& other) noexcept;  // NOLINT
 
+    template <typename Y, typename = enable_if_compatible_t<Y, T>>
+    SharedPtr(SharedPtr<Y>&& other) noexcept;  // NOLINT
+
+    // Aliasing constructor: shares ownership with r but points to ptr
     template <typename Y>
+    SharedPtr(const SharedPtr<Y>& r, element_type* ptr) noexcept;
+
+    template <typename Y>
+    SharedPtr(SharedPtr<Y>&& r, element_type* ptr) noexcept;
+
+    SharedPtr& operator=(const SharedPtr& r) noexcept;
+
+    template <typename Y, typename = enable_if_compatible_t<Y, T>>
     SharedPtr& operator=(const SharedPtr<Y>& r) noexcept;
 
     SharedPtr& operator=(SharedPtr&& r) noexcept;
 
-    template <typename Y>
+    template <typename Y, typename = enable_if_compatible_t<Y, T>>
     SharedPtr& operator=(SharedPtr<Y>&& r) noexcept;
 
     // Modifiers
@@ -45,28 +71,108 @@ public:
     void Swap(SharedPtr& other) noexcept;
 
     // Observers
-    T* Get() const noexcept;
+    element_type* Get() const noexcept;
     int64_t UseCount() const noexcept;
-    T& operator*() const noexcept;
-    T* operator->() const noexcept;
+    element_type& operator*() const noexcept;
+    element_type* operator->() const noexcept;
     element_type& operator[](std::ptrdiff_t idx) const;
     explicit operator bool() const noexcept;
 
+    template <typename U>
+    friend class SharedPtr;
+
     template <typename U>
     friend class WeakPtr;
 
+    template <typename U>
+    friend class AtomicSharedPtr;
+
+    template <typename U, typename... Args>
+    friend SharedPtr<U> MakeShared(Args&&... args);
+
+    template <typename U, typename... Args>
+    friend SharedPtr<U> MakeSharedBiased(Args&&... args);
+
+    template <typename U, typename... Args>
+    friend SharedPtr<U> MakeSharedDeferred(Args&&... args);
+
 private:
+    template <typename Y>
+    using default_deleter =
+        std::conditional_t<std::is_array_v<T>, std::default_delete<T>, std::default_delete<Y>>;
+
+    // Takes the first reference to a block that holds the object itself
+    template <typename Block>
+    static SharedPtr FromInplace(Block* control_block) noexcept;
+
+    template <typename Y, typename U>
+    void EnableWeakThis(const EnableSharedFromThis<U>* e, Y* p) noexcept;
+
+    void EnableWeakThis(...) noexcept {
+    }
+
     element_type* ptr_ = nullptr;
     SharedWeakCount* control_block_ = nullptr;
 };
 
 // MakeShared
+// MakeShared<T[]>(n) puts the counters and all n elements into one allocation
 template <typename T, typename... Args>
 SharedPtr<T> MakeShared(Args&&... args) {
-    return SharedPtr<T>(new T(std::forward<Args>(args)...));
+    if constexpr (std::is_array_v<T>) {
+        static_assert(std::extent_v<T> == 0 && sizeof...(Args) == 1,
+                      "expected MakeShared<T[]>(size)");
+        auto* control_block =
+            InplaceArrayControlBlock<std::remove_extent_t<T>>::Create(std::forward<Args>(args)...);
+        control_block->AddShared();
+        return SharedPtr<T>::FromInplace(control_block);
+    } else {
+        auto* control_block = new InplaceControlBlock<T>(std::forward<Args>(args)...);
+        control_block->AddShared();
+        return SharedPtr<T>::FromInplace(control_block);
+    }
+}
+
+// The last release only queues the object; it is destroyed on the Reclaimer thread
+template <typename T, typename... Args>
+SharedPtr<T> MakeSharedDeferred(Args&&... args) {
+    // Starts the thread and registers its shutdown before the first block exists
+    Reclaimer::Instance();
+    auto* control_block =
+        new DeferredControlBlock<InplaceControlBlock<T>>(std::forward<Args>(args)...);
+    control_block->AddShared();
+    return SharedPtr<T>::FromInplace(control_block);
 }
 // MakeShared
 
+// PointerCasts
+template <typename T, typename U>
+SharedPtr<T> StaticPointerCast(const SharedPtr<U>& r) noexcept {
+    using element_type = typename SharedPtr<T>::element_type;
+    return SharedPtr<T>(r, static_cast<element_type*>(r.Get()));
+}
+
+template <typename T, typename U>
+SharedPtr<T> StaticPointerCast(SharedPtr<U>&& r) noexcept {
+    using element_type = typename SharedPtr<T>::element_type;
+    element_type* ptr = static_cast<element_type*>(r.Get());
+    return SharedPtr<T>(std::move(r), ptr);
+}
+
+template <typename T, typename U>
+SharedPtr<T> DynamicPointerCast(const SharedPtr<U>& r) noexcept {
+    using element_type = typename SharedPtr<T>::element_type;
+    element_type* ptr = dynamic_cast<element_type*>(r.Get());
+    return ptr == nullptr ? SharedPtr<T>() : SharedPtr<T>(r, ptr);
+}
+
+template <typename T, typename U>
+SharedPtr<T> ReinterpretPointerCast(const SharedPtr<U>& r) noexcept {
+    using element_type = typename SharedPtr<T>::element_type;
+    return SharedPtr<T>(r, reinterpret_cast<element_type*>(r.Get()));
+}
+// PointerCasts
+
 // SharedPtr
 template <typename T>
 SharedPtr<T>::~SharedPtr() {
@@ -77,17 +183,36 @@ SharedPtr<T>::~SharedPtr() {
     control_block_ = nullptr;
 }
 
+template <typename T>
+template <typename Block>
+SharedPtr<T> SharedPtr<T>::FromInplace(Block* control_block) noexcept {
+    SharedPtr<T> res;
+    res.ptr_ = control_block->Get();
+    res.control_block_ = control_block;
+    if constexpr (!std::is_array_v<T>) {
+        res.EnableWeakThis(res.ptr_, res.ptr_);
+    }
+    return res;
+}
+
 template <typename T>
 template <typename Y>
-SharedPtr<T>::SharedPtr(Y* p) : ptr_(p), control_block_(new ControlBlock<T*>(p)) {
+SharedPtr<T>::SharedPtr(Y* p)
+    : ptr_(p), control_block_(new ControlBlock<Y*, default_deleter<Y>>(p)) {
     control_block_->AddShared();
+    if constexpr (!std::is_array_v<T>) {
+        EnableWeakThis(p, p);
+    }
 }
 
 template <typename T>
 template <typename Y, typename Deleter>
 SharedPtr<T>::SharedPtr(Y* p, Deleter deleter) noexcept
-    : ptr_(p), control_block_(new ControlBlock<T*, Deleter>(p, deleter)) {
+    : ptr_(p), control_block_(new ControlBlock<Y*, Deleter>(p, deleter)) {
     control_block_->AddShared();
+    if constexpr (!std::is_array_v<T>) {
+        EnableWeakThis(p, p);
+    }
 }
 
 template <typename T>
@@ -105,18 +230,66 @@ SharedPtr<T>::SharedPtr(SharedPtr&& other) noexcept
     other.control_block_ = nullptr;
 }
 
+template <typename T>
+template <typename Y, typename>
+SharedPtr<T>::SharedPtr(const SharedPtr<Y>& other) noexcept
+    : ptr_(other.ptr_), control_block_(other.control_block_) {
+    if (control_block_ != nullptr) {
+        control_block_->AddShared();
+    }
+}
+
+template <typename T>
+template <typename Y, typename>
+SharedPtr<T>::SharedPtr(SharedPtr<Y>&& other) noexcept
+    : ptr_(other.ptr_), control_block_(other.control_block_) {
+    other.ptr_ = nullptr;
+    other.control_block_ = nullptr;
+}
+
+template <typename T>
+template <typename Y>
+SharedPtr<T>::SharedPtr(const SharedPtr<Y>& r, element_type* ptr) noexcept
+    : ptr_(ptr), control_block_(r.control_block_) {
+    if (control_block_ != nullptr) {
+        control_block_->AddShared();
+    }
+}
+
+template <typename T>
+template <typename Y>
+SharedPtr<T>::SharedPtr(SharedPtr<Y>&& r, element_type* ptr) noexcept
+    : ptr_(ptr), control_block_(r.control_block_) {
+    r.ptr_ = nullptr;
+    r.control_block_ = nullptr;
+}
+
 template <typename T>
 SharedPtr<T>& SharedPtr<T>::operator=(const SharedPtr<T>& r) noexcept {
     SharedPtr<T>(r).Swap(*this);
     return *this;
 }
 
+template <typename T>
+template <typename Y, typename>
+SharedPtr<T>& SharedPtr<T>::operator=(const SharedPtr<Y>& r) noexcept {
+    SharedPtr<T>(r).Swap(*this);
+    return *this;
+}
+
 template <typename T>
 SharedPtr<T>& SharedPtr<T>::operator=(SharedPtr<T>&& r) noexcept {
     SharedPtr<T>(std::move(r)).Swap(*this);
     return *this;
 }
 
+template <typename T>
+template <typename Y, typename>
+SharedPtr<T>& SharedPtr<T>::operator=(SharedPtr<Y>&& r) noexcept {
+    SharedPtr<T>(std::move(r)).Swap(*this);
+    return *this;
+}
+
 template <typename T>
 void SharedPtr<T>::Reset() noexcept {
     SharedPtr<T>().Swap(*this);
@@ -141,7 +314,7 @@ void SharedPtr<T>::Swap(SharedPtr& other) noexcept {
 }
 
 template <typename T>
-T* SharedPtr<T>::Get() const noexcept {
+typename SharedPtr<T>::element_type* SharedPtr<T>::Get() const noexcept {
     return ptr_;
 }
 
@@ -151,18 +324,18 @@ int64_t SharedPtr<T>::UseCount() const noexcept {
 }
 
 template <typename T>
-T& SharedPtr<T>::operator*() const noexcept {
+typename SharedPtr<T>::element_type& SharedPtr<T>::operator*() const noexcept {
     return *ptr_;
 }
 
 template <typename T>
-T* SharedPtr<T>::operator->() const noexcept {
+typename SharedPtr<T>::element_type* SharedPtr<T>::operator->() const noexcept {
     return ptr_;
 }
 
 template <typename T>
 typename SharedPtr<T>::element_type& SharedPtr<T>::operator[](std::ptrdiff_t idx) const {
-    return ptr_ == nullptr ? nullptr : *(ptr_ + idx);
+    return ptr_[idx];
 }
 
 template <typename T>
@@ -175,15 +348,15 @@ SharedPtr<T>::operator bool() const noexcept {
 template <typename T>
 class WeakPtr {
 public:
-    using element_type = T;
+    using element_type = std::remove_extent_t<T>;
 
     // Special-member functions
     constexpr WeakPtr() noexcept = default;
-    template <typename Y>
+    template <typename Y, typename = enable_if_compatible_t<Y, T>>
     explicit WeakPtr(const SharedPtr<Y>& other);
     WeakPtr(const WeakPtr& other) noexcept;
     WeakPtr(WeakPtr&& other) noexcept;
-    template <typename Y>
+    template <typename Y, typename = enable_if_compatible_t<Y, T>>
     WeakPtr& operator=(const SharedPtr<Y>& other);
     WeakPtr& operator=(const WeakPtr& other) noexcept;
     WeakPtr& operator=(WeakPtr&& other) noexcept;
@@ -208,7 +381,7 @@ public:
 
 // WeakPtr
 template <typename T>
-template <typename Y>
+template <typename Y, typename>
 WeakPtr<T>::WeakPtr(const SharedPtr<Y>& other)
     : ptr_(other.ptr_), control_block_(other.control_block_) {
     if (control_block_ != nullptr) {
@@ -232,7 +405,7 @@ WeakPtr<T>::WeakPtr(WeakPtr&& other) noexcept
 }
 
 template <typename T>
-template <typename Y>
+template <typename Y, typename>
 WeakPtr<T>& WeakPtr<T>::operator=(const SharedPtr<Y>& other) {
     WeakPtr<T>(other).Swap(*this);
     return *this;
@@ -279,14 +452,76 @@ bool WeakPtr<T>::Expired() const noexcept {
 
 template <typename T>
 SharedPtr<T> WeakPtr<T>::Lock() const noexcept {
-    if (Expired()) {
-        return SharedPtr<T>();
+    SharedPtr<T> res;
+    if (control_block_ != nullptr && control_block_->AddSharedIfNotZero()) {
+        res.ptr_ = ptr_;
+        res.control_block_ = control_block_;
     }
+    return res;
+}
+// WeakPtr
 
-    SharedPtr<T> res;
-    res.ptr_ = ptr_;
-    res.control_block_ = control_block_;
-    control_block_->AddShared();
+// EnableSharedFromThis
+template <typename T>
+class EnableSharedFromThis {
+public:
+    SharedPtr<T> SharedFromThis();
+    SharedPtr<const T> SharedFromThis() const;
+
+    WeakPtr<T> WeakFromThis() noexcept;
+    WeakPtr<const T> WeakFromThis() const noexcept;
+
+    template <typename U>
+    friend class SharedPtr;
+
+protected:
+    constexpr EnableSharedFromThis() noexcept = default;
+    EnableSharedFromThis(const EnableSharedFromThis&) noexcept {
+    }
+    EnableSharedFromThis& operator=(const EnableSharedFromThis&) noexcept {
+        return *this;
+    }
+    ~EnableSharedFromThis() = default;
+
+private:
+    // Bound by the first SharedPtr that takes ownership of the object
+    mutable WeakPtr<T> weak_this_;
+};
+
+template <typename T>
+SharedPtr<T> EnableSharedFromThis<T>::SharedFromThis() {
+    return weak_this_.Lock();
+}
+
+template <typename T>
+SharedPtr<const T> EnableSharedFromThis<T>::SharedFromThis() const {
+    return WeakFromThis().Lock();
+}
+
+template <typename T>
+WeakPtr<T> EnableSharedFromThis<T>::WeakFromThis() noexcept {
+    return weak_this_;
+}
+
+template <typename T>
+WeakPtr<const T> EnableSharedFromThis<T>::WeakFromThis() const noexcept {
+    WeakPtr<const T> res;
+    res.ptr_ = weak_this_.ptr_;
+    res.control_block_ = weak_this_.control_block_;
+    if (res.control_block_ != nullptr) {
+        res.control_block_->AddWeak();
+    }
     return res;
 }
-// WeakPtr
\ No newline at end of file
+
+template <typename T>
+template <typename Y, typename U>
+void SharedPtr<T>::EnableWeakThis(const EnableSharedFromThis<U>* e, Y* p) noexcept {
+    if (e != nullptr && e->weak_this_.Expired()) {
+        e->weak_this_.Reset();
+        e->weak_this_.ptr_ = p;
+        e->weak_this_.control_block_ = control_block_;
+        control_block_->AddWeak();
+    }
+}
+// EnableSharedFromThis
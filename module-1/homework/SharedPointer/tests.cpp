@@ -1,7 +1,14 @@
 #include <algorithm>
+#include <cstdio>
+#include <cstdlib>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "gtest/gtest.h"
+#include "src/atomic_shared_ptr/atomic_shared_ptr.h"
+#include "src/intrusive_ptr/intrusive_ptr.h"
+#include "src/shared_ptr/biased_shared_ptr.h"
 #include "src/shared_ptr/shared_ptr.h"
 
 // WeakPtr
@@ -47,6 +54,36 @@ TEST(WeakLock, Test2) {
     ASSERT_FALSE(w.Lock());
 }
 
+TEST(WeakLock, Test3) {
+    for (int32_t i = 0; i < 200; ++i) {
+        auto sp = MakeShared<std::string>(std::to_string(i));
+        WeakPtr<std::string> w(sp);
+        std::atomic<bool> start{false};
+        std::vector<std::thread> lockers;
+
+        for (int32_t j = 0; j < 4; ++j) {
+            lockers.emplace_back([&w, &start, i] {
+                while (!start) {
+                }
+                for (int32_t k = 0; k < 100; ++k) {
+                    SharedPtr<std::string> locked = w.Lock();
+                    if (locked) {
+                        ASSERT_EQ(*locked, std::to_string(i));
+                    }
+                }
+            });
+        }
+
+        start = true;
+        sp.Reset();
+
+        for (auto& locker : lockers) {
+            locker.join();
+        }
+        ASSERT_TRUE(w.Expired() && !w.Lock());
+    }
+}
+
 // SharedPtr
 TEST(SharedMoveConstructor, Test1) {
     class Contrainer {};
@@ -157,6 +194,406 @@ TEST(SharedBoolOperator, Test2) {
     ASSERT_FALSE(s1);
 }
 
+TEST(SharedConversion, Test1) {
+    struct Base {
+        virtual ~Base() = default;
+    };
+    struct Derived : Base {
+        int32_t value = 7;
+    };
+
+    SharedPtr<Derived> derived = MakeShared<Derived>();
+    SharedPtr<Base> base = derived;
+    ASSERT_TRUE(base.Get() == derived.Get() && derived.UseCount() == 2);
+
+    SharedPtr<Derived> back = DynamicPointerCast<Derived>(base);
+    ASSERT_TRUE(back.Get() == derived.Get() && back->value == 7 && derived.UseCount() == 3);
+
+    struct Other : Base {};
+    ASSERT_FALSE(DynamicPointerCast<Other>(base));
+
+    SharedPtr<Derived> moved = StaticPointerCast<Derived>(std::move(base));
+    ASSERT_TRUE(!base && moved.Get() == derived.Get() && derived.UseCount() == 3);
+}
+
+TEST(SharedAliasing, Test1) {
+    struct Buffer {
+        int32_t header = 1;
+        int32_t payload[4] = {2, 3, 4, 5};
+    };
+
+    SharedPtr<int32_t> payload;
+    {
+        SharedPtr<Buffer> buffer = MakeShared<Buffer>();
+        payload = SharedPtr<int32_t>(buffer, buffer->payload + 2);
+        ASSERT_TRUE(buffer.UseCount() == 2);
+    }
+    ASSERT_TRUE(*payload == 4 && payload.UseCount() == 1);
+}
+
+TEST(ControlBlockLayout, Test1) {
+    auto lambda_deleter = [](int32_t* p) { delete p; };
+
+    static_assert(sizeof(ControlBlock<int32_t*>) == 24, "expected counts + pointer only");
+    static_assert(sizeof(ControlBlock<int32_t*, decltype(lambda_deleter)>) == 24,
+                  "expected empty deleter to take no space");
+    static_assert(sizeof(InplaceControlBlock<int64_t>) == 24, "expected counts + object only");
+
+    SharedPtr<int32_t> s1(new int32_t(1), lambda_deleter);
+    SharedPtr<int32_t> s2 = s1;
+    ASSERT_TRUE(*s2 == 1 && s1.UseCount() == 2);
+}
+
+TEST(ControlBlockLayout, Test2) {
+    // The top bit of the shared count marks biased blocks, so a plain one must stop below it
+    GTEST_FLAG_SET(death_test_style, "threadsafe");
+    struct Probe : SharedCount {
+        Probe() : SharedCount((count_type{1} << 31) - 1) {
+        }
+
+        void OnZeroShared() noexcept override {
+        }
+    };
+
+    Probe probe;
+    EXPECT_DEBUG_DEATH(probe.AddShared(), "");
+}
+
+TEST(SharedArray, Test1) {
+    SharedPtr<int32_t[]> s1 = MakeShared<int32_t[]>(1000);
+    for (int32_t i = 0; i < 1000; ++i) {
+        ASSERT_EQ(s1[i], 0);
+        s1[i] = i;
+    }
+
+    SharedPtr<int32_t[]> s2 = s1;
+    ASSERT_TRUE(s2[999] == 999 && s1.UseCount() == 2);
+}
+
+TEST(SharedArray, Test2) {
+    SharedPtr<std::string[]> s1 = MakeShared<std::string[]>(3);
+    s1[2] = "last";
+    WeakPtr<std::string[]> w(s1);
+    ASSERT_TRUE(w.Lock()[2] == "last");
+
+    s1.Reset(new std::string[2]);
+    ASSERT_TRUE(w.Expired() && s1[1].empty());
+}
+
+TEST(SharedArray, Test3) {
+    struct Base {
+        int32_t value = 0;
+    };
+    struct Derived : Base {
+        int32_t extra = 0;
+    };
+
+    static_assert(std::is_convertible_v<SharedPtr<Derived>, SharedPtr<Base>>);
+    static_assert(std::is_convertible_v<SharedPtr<int32_t[]>, SharedPtr<const int32_t[]>>);
+    static_assert(!std::is_constructible_v<SharedPtr<Base[]>, SharedPtr<Derived[]>>);
+    static_assert(!std::is_assignable_v<SharedPtr<Base[]>&, SharedPtr<Derived[]>>);
+    static_assert(!std::is_constructible_v<SharedPtr<int32_t>, SharedPtr<int32_t[]>>);
+    static_assert(!std::is_constructible_v<WeakPtr<Base[]>, SharedPtr<Derived[]>>);
+
+    SharedPtr<int32_t[]> s1 = MakeShared<int32_t[]>(2);
+    SharedPtr<const int32_t[]> s2 = s1;
+    ASSERT_TRUE(s2.Get() == s1.Get() && s1.UseCount() == 2);
+}
+
+// EnableSharedFromThis
+TEST(SharedFromThis, Test1) {
+    struct Handler : EnableSharedFromThis<Handler> {
+        SharedPtr<Handler> Self() {
+            return SharedFromThis();
+        }
+    };
+
+    SharedPtr<Handler> s1 = MakeShared<Handler>();
+    SharedPtr<Handler> s2 = s1->Self();
+    ASSERT_TRUE(s1.Get() == s2.Get() && s1.UseCount() == 2 && s2.UseCount() == 2);
+}
+
+TEST(SharedFromThis, Test2) {
+    struct Handler : EnableSharedFromThis<Handler> {};
+
+    WeakPtr<Handler> w;
+    {
+        SharedPtr<Handler> s1(new Handler);
+        w = s1->WeakFromThis();
+        ASSERT_FALSE(w.Expired());
+    }
+    ASSERT_TRUE(w.Expired());
+}
+
+TEST(SharedFromThis, Test3) {
+    struct Handler : EnableSharedFromThis<Handler> {};
+
+    Handler unowned;
+    ASSERT_FALSE(unowned.SharedFromThis());
+}
+
+TEST(SharedFromThis, Test4) {
+    struct Handler : EnableSharedFromThis<Handler> {};
+
+    // Elements of an owned array are not owned one by one
+    SharedPtr<Handler[]> s1(new Handler[2], std::default_delete<Handler[]>());
+    ASSERT_TRUE(s1[0].WeakFromThis().Expired() && s1.UseCount() == 1);
+}
+
+// MakeSharedBiased
+TEST(SharedBiased, Test1) {
+    SharedPtr<std::string> s1 = MakeSharedBiased<std::string>("biased");
+    SharedPtr<std::string> s2 = s1;
+    {
+        SharedPtr<std::string> s3 = s2;
+        ASSERT_TRUE(s1.UseCount() == 3);
+    }
+    WeakPtr<std::string> w(s1);
+    s1.Reset();
+    ASSERT_TRUE(*s2 == "biased" && s2.UseCount() == 1 && !w.Expired());
+
+    s2.Reset();
+    ASSERT_TRUE(w.Expired());
+}
+
+TEST(SharedBiased, Test2) {
+    int32_t destroyed = 0;
+    struct Counted {
+        int32_t* destroyed;
+        ~Counted() {
+            ++*destroyed;
+        }
+    };
+
+    SharedPtr<Counted> s1 = MakeSharedBiased<Counted>(Counted{&destroyed});
+    std::vector<SharedPtr<Counted>> copies(8, s1);
+
+    std::vector<std::thread> releasers;
+    for (auto& copy : copies) {
+        releasers.emplace_back([copy = std::move(copy)]() mutable {
+            SharedPtr<Counted> local = copy;
+            copy.Reset();
+        });
+    }
+    for (auto& releaser : releasers) {
+        releaser.join();
+    }
+
+    ASSERT_TRUE(s1.UseCount() == 1 && destroyed == 1);
+    s1.Reset();
+    ASSERT_TRUE(destroyed == 2);
+}
+
+TEST(SharedBiased, Test3) {
+    std::atomic<int32_t> destroyed{0};
+    struct Counted {
+        std::atomic<int32_t>* destroyed;
+        ~Counted() {
+            ++*destroyed;
+        }
+    };
+
+    SharedPtr<Counted> handed_out;
+    std::thread owner([&handed_out, &destroyed] {
+        SharedPtr<Counted> s1 = MakeSharedBiased<Counted>(Counted{&destroyed});
+        handed_out = s1;
+    });
+    owner.join();
+
+    ASSERT_TRUE(destroyed == 1 && handed_out.UseCount() == 1);
+    handed_out.Reset();
+    ASSERT_TRUE(destroyed == 2);
+}
+
+TEST(SharedBiased, Test4) {
+    std::atomic<int32_t> destroyed{0};
+    struct Counted {
+        std::atomic<int32_t>* destroyed;
+        ~Counted() {
+            ++*destroyed;
+        }
+    };
+
+    // The owner keeps running but holds nothing once the other thread drops the last copy
+    SharedPtr<Counted> handed;
+    WeakPtr<Counted> w;
+    std::atomic<bool> released{false};
+    std::atomic<bool> checked{false};
+    std::thread owner([&] {
+        SharedPtr<Counted> s1 = MakeSharedBiased<Counted>(Counted{&destroyed});
+        handed = s1;
+        w = s1;
+        s1.Reset();
+        released = true;
+        while (!checked) {
+            std::this_thread::yield();
+        }
+    });
+    while (!released) {
+        std::this_thread::yield();
+    }
+
+    std::thread([&handed] { handed.Reset(); }).join();
+    bool expired = w.Expired();
+    bool locked = static_cast<bool>(w.Lock());
+    int32_t destroyed_before_exit = destroyed;
+    checked = true;
+    owner.join();
+
+    ASSERT_TRUE(destroyed_before_exit == 2 && expired && !locked);
+}
+
+// MakeSharedDeferred
+TEST(SharedDeferred, Test1) {
+    struct Heavy {
+        std::thread::id* destroyed_on;
+        ~Heavy() {
+            if (destroyed_on != nullptr) {
+                *destroyed_on = std::this_thread::get_id();
+            }
+        }
+    };
+
+    std::thread::id destroyed_on;
+    SharedPtr<Heavy> s1 = MakeSharedDeferred<Heavy>(Heavy{nullptr});
+    s1->destroyed_on = &destroyed_on;
+    WeakPtr<Heavy> w(s1);
+
+    s1.Reset();
+    ASSERT_TRUE(w.Expired() && !w.Lock());
+
+    Reclaimer::Instance().Flush();
+    ASSERT_TRUE(destroyed_on != std::thread::id() && destroyed_on != std::this_thread::get_id());
+}
+
+struct LoudOnReclaim {
+    ~LoudOnReclaim() {
+        std::fputs("reclaimed", stderr);
+    }
+};
+
+// Constructed before any deferred block, so it is destroyed after the reclaimer stops
+SharedPtr<LoudOnReclaim> early_deferred;
+
+TEST(SharedDeferred, Test2) {
+    // Objects still owned at exit are reclaimed whichever static was constructed first
+    GTEST_FLAG_SET(death_test_style, "threadsafe");
+
+    EXPECT_EXIT(
+        {
+            static SharedPtr<LoudOnReclaim> s = MakeSharedDeferred<LoudOnReclaim>();
+            MakeSharedDeferred<int32_t>(0).Reset();
+            Reclaimer::Instance().Flush();
+            std::exit(0);
+        },
+        testing::ExitedWithCode(0), "reclaimed");
+
+    EXPECT_EXIT(
+        {
+            early_deferred = MakeSharedDeferred<LoudOnReclaim>();
+            std::exit(0);
+        },
+        testing::ExitedWithCode(0), "reclaimed");
+}
+
+// AtomicSharedPtr
+TEST(AtomicLoadStore, Test1) {
+    AtomicSharedPtr<int32_t> a;
+    ASSERT_FALSE(a.Load());
+
+    auto sp = MakeShared<int32_t>(42);
+    a.Store(sp);
+    ASSERT_TRUE(sp.UseCount() == 2);
+    ASSERT_TRUE(a.Load().Get() == sp.Get());
+
+    a.Store(SharedPtr<int32_t>());
+    ASSERT_TRUE(!a.Load() && sp.UseCount() == 1);
+}
+
+TEST(AtomicExchange, Test1) {
+    auto first = MakeShared<int32_t>(1);
+    auto second = MakeShared<int32_t>(2);
+    AtomicSharedPtr<int32_t> a(first);
+
+    SharedPtr<int32_t> old = a.Exchange(second);
+    ASSERT_TRUE(old.Get() == first.Get() && *a.Load() == 2 && first.UseCount() == 2);
+}
+
+TEST(AtomicCompareExchange, Test1) {
+    auto first = MakeShared<int32_t>(1);
+    auto second = MakeShared<int32_t>(2);
+    AtomicSharedPtr<int32_t> a(first);
+
+    SharedPtr<int32_t> expected = second;
+    ASSERT_FALSE(a.CompareExchange(expected, second));
+    ASSERT_TRUE(expected.Get() == first.Get());
+
+    ASSERT_TRUE(a.CompareExchange(expected, second));
+    ASSERT_TRUE(a.Load().Get() == second.Get() && first.UseCount() == 2);
+}
+
+TEST(AtomicConcurrent, Test1) {
+    AtomicSharedPtr<int32_t> a(MakeShared<int32_t>(0));
+    std::vector<std::thread> readers;
+    std::atomic<bool> stop{false};
+
+    for (int32_t i = 0; i < 4; ++i) {
+        readers.emplace_back([&] {
+            while (!stop) {
+                SharedPtr<int32_t> snapshot = a.Load();
+                ASSERT_TRUE(snapshot && *snapshot >= 0);
+            }
+        });
+    }
+
+    for (int32_t i = 1; i <= 10000; ++i) {
+        a.Store(MakeShared<int32_t>(i));
+    }
+    stop = true;
+
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    SharedPtr<int32_t> last = a.Load();
+    ASSERT_TRUE(*last == 10000 && last.UseCount() == 2);
+}
+
+// IntrusivePtr
+TEST(Intrusive, Test1) {
+    struct Node : IntrusiveRefCounter<Node> {
+        int32_t value = 5;
+    };
+
+    static_assert(sizeof(IntrusivePtr<Node>) == sizeof(Node*), "expected one pointer");
+
+    IntrusivePtr<Node> i1 = MakeIntrusive<Node>();
+    IntrusivePtr<Node> i2 = i1;
+    {
+        IntrusivePtr<Node> i3(i2.Get());
+        ASSERT_TRUE(i1.UseCount() == 3);
+    }
+    ASSERT_TRUE(i1->value == 5 && i1.UseCount() == 2 && i1.Get() == i2.Get());
+
+    i1.Reset();
+    ASSERT_TRUE(!i1 && i2.UseCount() == 1);
+}
+
+TEST(Intrusive, Test2) {
+    struct Base : IntrusiveRefCounter<Base> {
+        virtual ~Base() = default;
+    };
+    struct Derived : Base {};
+
+    IntrusivePtr<Derived> derived = MakeIntrusive<Derived>();
+    IntrusivePtr<Base> base = derived;
+    ASSERT_TRUE(base.UseCount() == 2);
+
+    Derived* raw = derived.Detach();
+    ASSERT_TRUE(!derived && base.UseCount() == 2);
+    IntrusivePtr<Derived> adopted(raw, false);
+    ASSERT_TRUE(base.UseCount() == 2);
+}
+
 int main(int argc, char** argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
@@ -0,0 +1,76 @@
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+#include "typelist/soa.h"
+
+// Sums one int field over 4M rows, kept once in an SoA table and once as std::vector of a
+// 64-byte row struct. Not part of the test run; take numbers from an optimized build, e.g.
+//   g++ -std=c++17 -O2 benchmark.cpp -o benchmark
+
+namespace {
+
+constexpr std::size_t kRows = 4'000'000;
+constexpr int kPasses = 20;
+
+struct Row {
+    int32_t value;
+    double weight;
+    std::array<double, 3> position;
+    int64_t stamp;
+    std::array<char, 16> tag;
+};
+
+static_assert(sizeof(Row) == 64);
+
+typedef TypeList<int32_t, TypeList<double, TypeList<std::array<double, 3>, TypeList<int64_t,
+        TypeList<std::array<char, 16>, NullType>>>>>
+    RowTypes;
+
+template<typename F>
+double Milliseconds(F&& f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+        .count();
+}
+
+}  // namespace
+
+int main() {
+    std::vector<Row> rows;
+    SoA<RowTypes> table;
+    rows.reserve(kRows);
+    table.Reserve(kRows);
+    for (std::size_t i = 0; i < kRows; ++i) {
+        Row row{static_cast<int32_t>(i % 1000), 0.5 * i, {}, static_cast<int64_t>(i), {}};
+        rows.push_back(row);
+        table.PushBack(row.value, row.weight, row.position, row.stamp, row.tag);
+    }
+
+    int64_t rows_sum = 0;
+    double ms = Milliseconds([&] {
+        for (int pass = 0; pass < kPasses; ++pass) {
+            for (const Row& row : rows) {
+                rows_sum += row.value;
+            }
+        }
+    });
+    std::cout << kPasses << " sums over " << kRows << " rows\n";
+    std::cout << "  std::vector<Row> " << ms << " ms\n";
+
+    int64_t table_sum = 0;
+    ms = Milliseconds([&] {
+        for (int pass = 0; pass < kPasses; ++pass) {
+            for (int32_t value : table.Column<0>()) {
+                table_sum += value;
+            }
+        }
+    });
+    std::cout << "  SoA column       " << ms << " ms\n";
+
+    return rows_sum == table_sum ? 0 : 1;
+}
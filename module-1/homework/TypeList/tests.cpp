@@ -1,14 +1,18 @@
 #include <algorithm>
 #include <cmath>
 #include <iostream>
+#include <stdexcept>
 #include <string>
+#include <utility>
 
 #include "typelist/append.h"
+#include "typelist/dispatch.h"
 #include "typelist/eraseall.h"
 #include "typelist/indexof.h"
 #include "typelist/length.h"
 #include "typelist/noduplicates.h"
 #include "typelist/replace.h"
+#include "typelist/soa.h"
 #include "typelist/typeat.h"
 
 #include "gtest/gtest.h"
@@ -115,3 +119,98 @@ TEST(TypeAt, Test1) {
  
     ASSERT_TRUE((std::is_same<TypeAt<actual, 1>::TargetType, expected>::value));
 }
+
+template<int N>
+struct Tag {};
+
+template<std::size_t... Is>
+TypePack<Tag<Is>...> MakeTags(std::index_sequence<Is...>);
+
+TEST(Long, Test1) {
+    typedef decltype(MakeTags(std::make_index_sequence<500>())) pack;
+    typedef FromPack<concat_t<pack, pack>>::type actual;
+
+    ASSERT_EQ(Length<actual>::length, 1000u);
+    testing::StaticAssertTypeEq<TypeAt<actual, 777>::TargetType, Tag<277>>();
+    ASSERT_EQ((IndexOf<actual, Tag<499>>::pos), 499);
+    ASSERT_EQ(Length<NoDuplicates<actual>::NewTypeList>::length, 500u);
+    ASSERT_EQ((Length<EraseAll<actual, Tag<3>>::NewTypeList>::length), 998u);
+    ASSERT_EQ((IndexOf<Erase<actual, Tag<3>>::NewTypeList, Tag<3>>::pos), 502);
+    ASSERT_EQ((IndexOf<Replace<actual, Tag<3>, int>::NewTypeList, int>::pos), 3);
+}
+
+TEST(Dispatch, Test1) {
+    typedef TypeList<char, TypeList<int, TypeList<double, NullType>>> list;
+
+    auto size = [](auto tag) { return sizeof(typename decltype(tag)::type); };
+
+    ASSERT_EQ(Dispatch<list>(0, size), sizeof(char));
+    ASSERT_EQ(Dispatch<list>(IndexOf<list, int>::pos, size), sizeof(int));
+    ASSERT_EQ(Dispatch<list>(2, size), sizeof(double));
+    ASSERT_THROW(Dispatch<list>(3, size), std::out_of_range);
+}
+
+TEST(Dispatch, Test2) {
+    typedef TypeList<int, TypeList<std::string, NullType>> list;
+
+    std::string seen;
+    auto record = [&seen](auto tag) {
+        seen += std::is_same_v<typename decltype(tag)::type, int> ? 'i' : 's';
+    };
+
+    for (unsigned int tag : {1, 0, 0, 1}) {
+        Dispatch<list>(tag, record);
+    }
+    ASSERT_EQ(seen, "siis");
+}
+
+TEST(SoA, Test1) {
+    SoA<TypeList<int, TypeList<double, TypeList<std::string, NullType>>>> table;
+    ASSERT_TRUE(table.Empty());
+
+    table.Reserve(4);
+    ASSERT_GE(table.Capacity(), 4u);
+
+    for (int i = 0; i < 10; ++i) {
+        table.PushBack(i, i * 0.5, std::to_string(i));
+    }
+    ASSERT_EQ(table.Size(), 10u);
+
+    int sum = 0;
+    for (int value : table.Column<0>()) {
+        sum += value;
+    }
+    ASSERT_EQ(sum, 45);
+    ASSERT_EQ(table.Column<1>()[3], 1.5);
+
+    table[7].Get<2>() += "!";
+    const auto& view = table;
+    ASSERT_EQ(view[7].Get<2>(), "7!");
+    ASSERT_EQ(view[7].Get<0>(), 7);
+
+    testing::StaticAssertTypeEq<decltype(view.Column<2>()), ColumnSpan<const std::string>>();
+
+    table.Clear();
+    ASSERT_EQ(table.Column<2>().Size(), 0u);
+}
+
+struct ThrowOnCopy {
+    ThrowOnCopy() = default;
+
+    ThrowOnCopy(ThrowOnCopy&&) = default;
+
+    ThrowOnCopy(const ThrowOnCopy&) {
+        throw std::runtime_error("copy");
+    }
+};
+
+TEST(SoA, Test2) {
+    SoA<TypeList<int, TypeList<ThrowOnCopy, NullType>>> table;
+    table.PushBack(1, ThrowOnCopy());
+
+    ThrowOnCopy value;
+    ASSERT_THROW(table.PushBack(2, value), std::runtime_error);
+    ASSERT_EQ(table.Size(), 1u);
+    ASSERT_EQ(table.Column<0>().Size(), 1u);
+    ASSERT_EQ(table[0].Get<0>(), 1);
+}
@@ -1,6 +1,22 @@
 #pragma once
 
 #include "typelist.h"
+#include "typepack.h"
+
+// Appending NullType adds nothing, appending a TypeList adds all of its types
+template<typename NewType>
+struct AppendedTypes {
+    typedef TypePack<NewType> type;
+};
+
+template<>
+struct AppendedTypes<NullType> : ToPack<NullType> {};
+
+template<typename Head, typename Tail>
+struct AppendedTypes<TypeList<Head, Tail>> : ToPack<TypeList<Head, Tail>> {};
 
 template<typename TList, typename NewType>
-struct Append;
\ No newline at end of file
+struct Append {
+    typedef typename FromPack<concat_t<typename ToPack<TList>::type,
+                                       typename AppendedTypes<NewType>::type>>::type NewTypeList;
+};
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <array>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "typelist.h"
+#include "typepack.h"
+
+// Dispatch - a runtime type tag, the position of a type in the list as IndexOf reports it,
+// selects f(TypeTag<T>{}) for the type at that position with one indexed indirect call
+
+template<typename Pack, typename F>
+struct DispatchTable;
+
+template<typename T, typename... Ts, typename F>
+struct DispatchTable<TypePack<T, Ts...>, F> {
+    typedef std::invoke_result_t<F, TypeTag<T>> result_type;
+
+    static_assert((std::is_same_v<result_type, std::invoke_result_t<F, TypeTag<Ts>>> && ...),
+                  "the handler must return the same type for every type in the list");
+
+    typedef result_type (*handler_type)(F&&);
+
+    template<typename U>
+    static result_type Call(F&& f) {
+        return std::forward<F>(f)(TypeTag<U>{});
+    }
+
+    static constexpr std::array<handler_type, 1 + sizeof...(Ts)> kTable = {&Call<T>,
+                                                                          &Call<Ts>...};
+};
+
+template<typename TList, typename F>
+decltype(auto) Dispatch(unsigned int tag, F&& f) {
+    typedef DispatchTable<typename ToPack<TList>::type, F> table;
+
+    if (tag >= table::kTable.size()) {
+        throw std::out_of_range("type tag is out of range");
+    }
+    return table::kTable[tag](std::forward<F>(f));
+}
@@ -1,6 +1,14 @@
 #pragma once
 
 #include "typelist.h"
+#include "typepack.h"
 
 template<typename TList, typename TargetType>
-struct Erase;
\ No newline at end of file
+struct Erase {
+private:
+    typedef typename ToPack<TList>::type pack;
+
+public:
+    typedef typename FromPack<
+        typename PackEraseAt<pack, PackIndexOf<pack, TargetType>::value>::type>::type NewTypeList;
+};
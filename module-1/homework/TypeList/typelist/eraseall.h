@@ -1,6 +1,22 @@
 #pragma once
 
+#include <type_traits>
+
 #include "typelist.h"
+#include "typepack.h"
+
+template<typename Pack, typename TargetType>
+struct PackEraseAll;
+
+template<typename... Ts, typename TargetType>
+struct PackEraseAll<TypePack<Ts...>, TargetType> {
+    typedef concat_t<
+        std::conditional_t<std::is_same_v<Ts, TargetType>, TypePack<>, TypePack<Ts>>...>
+        type;
+};
 
 template<typename TList, typename TargetType>
-struct EraseAll;
\ No newline at end of file
+struct EraseAll {
+    typedef typename FromPack<
+        typename PackEraseAll<typename ToPack<TList>::type, TargetType>::type>::type NewTypeList;
+};
@@ -1,6 +1,9 @@
 #pragma once
 
 #include "typelist.h"
+#include "typepack.h"
 
 template<typename TList, typename TargetType>
-struct IndexOf;
\ No newline at end of file
+struct IndexOf {
+    static constexpr int pos = PackIndexOf<typename ToPack<TList>::type, TargetType>::value;
+};
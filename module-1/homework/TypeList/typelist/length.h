@@ -1,6 +1,9 @@
 #pragma once
 
 #include "typelist.h"
+#include "typepack.h"
 
 template<typename TList> 
-struct Length;
\ No newline at end of file
+struct Length {
+    static constexpr unsigned int length = PackLength<typename ToPack<TList>::type>::value;
+};
@@ -1,7 +1,35 @@
 #pragma once
 
+#include <type_traits>
+#include <utility>
+
 #include "erase.h"
 #include "typelist.h"
+#include "typepack.h"
+
+// Types are added one by one to a pack that also derives from all of them,
+// so checking for a duplicate is a base lookup instead of a scan
+template<typename... Ts>
+struct UniquePack : TypeTag<Ts>... {
+    typedef TypePack<Ts...> type;
+};
+
+template<typename... Ts, typename T>
+std::conditional_t<std::is_base_of_v<TypeTag<T>, UniquePack<Ts...>>, UniquePack<Ts...>,
+                   UniquePack<Ts..., T>>
+operator+(UniquePack<Ts...>, TypeTag<T>);
+
+template<typename Pack>
+struct PackNoDuplicates;
+
+template<typename... Ts>
+struct PackNoDuplicates<TypePack<Ts...>> {
+    typedef typename decltype((std::declval<UniquePack<>>() + ... +
+                               std::declval<TypeTag<Ts>>()))::type type;
+};
 
 template<typename TList>
-struct NoDuplicates;
\ No newline at end of file
+struct NoDuplicates {
+    typedef typename FromPack<
+        typename PackNoDuplicates<typename ToPack<TList>::type>::type>::type NewTypeList;
+};
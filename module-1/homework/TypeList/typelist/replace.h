@@ -1,6 +1,30 @@
 #pragma once
 
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
 #include "typelist.h"
+#include "typepack.h"
+
+// Replaces the type at Pos; Pos = -1 keeps the pack as is
+template<typename Pack, int Pos, typename NewType,
+         typename = std::make_index_sequence<PackLength<Pack>::value>>
+struct PackReplaceAt;
 
+template<typename... Ts, int Pos, typename NewType, std::size_t... Is>
+struct PackReplaceAt<TypePack<Ts...>, Pos, NewType, std::index_sequence<Is...>> {
+    typedef TypePack<std::conditional_t<static_cast<int>(Is) == Pos, NewType, Ts>...> type;
+};
+
+// Replaces the first occurrence of OldType, as Erase removes only the first one
 template<typename TList, typename OldType, typename NewType> 
-struct Replace;
\ No newline at end of file
+struct Replace {
+private:
+    typedef typename ToPack<TList>::type pack;
+
+public:
+    typedef typename FromPack<
+        typename PackReplaceAt<pack, PackIndexOf<pack, OldType>::value, NewType>::type>::type
+        NewTypeList;
+};
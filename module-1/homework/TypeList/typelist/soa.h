@@ -0,0 +1,205 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "length.h"
+#include "typeat.h"
+#include "typelist.h"
+#include "typepack.h"
+
+// SoA - a table whose row type is given by a TypeList; every type of the list is kept
+// in its own contiguous column, so scanning one field touches only that field's memory
+
+// ColumnSpan - a view of one column, invalidated by PushBack and Reserve
+template<typename T>
+class ColumnSpan {
+public:
+    ColumnSpan(T* data, std::size_t size) : data_(data), size_(size) {
+    }
+
+    T* begin() const {
+        return data_;
+    }
+
+    T* end() const {
+        return data_ + size_;
+    }
+
+    T& operator[](std::size_t index) const {
+        return data_[index];
+    }
+
+    T* Data() const {
+        return data_;
+    }
+
+    std::size_t Size() const {
+        return size_;
+    }
+
+private:
+    T* data_;
+    std::size_t size_;
+};
+// ColumnSpan
+
+// SoARow - a row proxy, Columns is const for rows of a const table
+template<typename Columns>
+class SoARow {
+public:
+    SoARow(Columns& columns, std::size_t index) : columns_(columns), index_(index) {
+    }
+
+    template<std::size_t Idx>
+    auto& Get() const {
+        return std::get<Idx>(columns_)[index_];
+    }
+
+private:
+    Columns& columns_;
+    std::size_t index_;
+};
+// SoARow
+
+template<typename Pack>
+struct SoAColumns;
+
+template<typename... Ts>
+struct SoAColumns<TypePack<Ts...>> {
+    // std::vector<bool> has no contiguous storage to hand out as a span
+    static_assert(!(std::is_same_v<Ts, bool> || ...), "bool columns are not supported");
+
+    typedef std::tuple<std::vector<Ts>...> type;
+};
+
+template<typename TList>
+class SoA {
+public:
+    static constexpr std::size_t kColumns = Length<TList>::length;
+
+    template<std::size_t Idx>
+    using column_type = typename TypeAt<TList, Idx>::TargetType;
+
+    typedef typename SoAColumns<typename ToPack<TList>::type>::type columns_type;
+    typedef SoARow<columns_type> row;
+    typedef SoARow<const columns_type> const_row;
+
+    std::size_t Size() const;
+
+    bool Empty() const;
+
+    std::size_t Capacity() const;
+
+    void Reserve(std::size_t capacity);
+
+    void Clear();
+
+    // Takes one value per column; a throwing column leaves the table unchanged
+    template<typename... Args>
+    void PushBack(Args&&... args);
+
+    row operator[](std::size_t index);
+
+    const_row operator[](std::size_t index) const;
+
+    template<std::size_t Idx>
+    ColumnSpan<column_type<Idx>> Column();
+
+    template<std::size_t Idx>
+    ColumnSpan<const column_type<Idx>> Column() const;
+
+private:
+    template<std::size_t... Is>
+    void ReserveColumns(std::size_t capacity, std::index_sequence<Is...>);
+
+    template<std::size_t... Is, typename... Args>
+    void PushColumns(std::index_sequence<Is...>, Args&&... args);
+
+    columns_type columns_;
+    std::size_t size_ = 0;
+};
+
+template<typename TList>
+std::size_t SoA<TList>::Size() const {
+    return size_;
+}
+
+template<typename TList>
+bool SoA<TList>::Empty() const {
+    return size_ == 0;
+}
+
+template<typename TList>
+std::size_t SoA<TList>::Capacity() const {
+    return std::apply([](const auto&... column) { return std::min({column.capacity()...}); },
+                      columns_);
+}
+
+template<typename TList>
+void SoA<TList>::Reserve(std::size_t capacity) {
+    ReserveColumns(capacity, std::make_index_sequence<kColumns>());
+}
+
+template<typename TList>
+void SoA<TList>::Clear() {
+    std::apply([](auto&... column) { (column.clear(), ...); }, columns_);
+    size_ = 0;
+}
+
+template<typename TList>
+template<typename... Args>
+void SoA<TList>::PushBack(Args&&... args) {
+    static_assert(sizeof...(Args) == kColumns, "PushBack takes one value per column");
+
+    // Columns grow together, so every column reallocates at most once per doubling
+    if (size_ == Capacity()) {
+        Reserve(std::max<std::size_t>(1, 2 * size_));
+    }
+    PushColumns(std::make_index_sequence<kColumns>(), std::forward<Args>(args)...);
+    ++size_;
+}
+
+template<typename TList>
+typename SoA<TList>::row SoA<TList>::operator[](std::size_t index) {
+    return row(columns_, index);
+}
+
+template<typename TList>
+typename SoA<TList>::const_row SoA<TList>::operator[](std::size_t index) const {
+    return const_row(columns_, index);
+}
+
+template<typename TList>
+template<std::size_t Idx>
+ColumnSpan<typename SoA<TList>::template column_type<Idx>> SoA<TList>::Column() {
+    return {std::get<Idx>(columns_).data(), size_};
+}
+
+template<typename TList>
+template<std::size_t Idx>
+ColumnSpan<const typename SoA<TList>::template column_type<Idx>> SoA<TList>::Column() const {
+    return {std::get<Idx>(columns_).data(), size_};
+}
+
+template<typename TList>
+template<std::size_t... Is>
+void SoA<TList>::ReserveColumns(std::size_t capacity, std::index_sequence<Is...>) {
+    (std::get<Is>(columns_).reserve(capacity), ...);
+}
+
+template<typename TList>
+template<std::size_t... Is, typename... Args>
+void SoA<TList>::PushColumns(std::index_sequence<Is...>, Args&&... args) {
+    std::size_t pushed = 0;
+    try {
+        ((std::get<Is>(columns_).emplace_back(std::forward<Args>(args)), ++pushed), ...);
+    } catch (...) {
+        ((Is < pushed ? std::get<Is>(columns_).pop_back() : void()), ...);
+        throw;
+    }
+}
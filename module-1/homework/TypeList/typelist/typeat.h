@@ -1,6 +1,9 @@
 #pragma once
 
 #include "typelist.h"
+#include "typepack.h"
 
 template<typename TList, unsigned int index>
-struct TypeAt;
\ No newline at end of file
+struct TypeAt {
+    typedef typename PackTypeAt<typename ToPack<TList>::type, index>::type TargetType;
+};
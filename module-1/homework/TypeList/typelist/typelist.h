@@ -1,6 +1,9 @@
 #pragma once
 
 template<typename Head, typename Tail> 
-struct TypeList;
+struct TypeList {
+    typedef Head head;
+    typedef Tail tail;
+};
 
-struct NullType {};
\ No newline at end of file
+struct NullType {};
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include "typelist.h"
+
+// The algorithms work on a flat parameter pack rather than on the nested TypeList:
+// a list is converted once, eight links per step, and every operation on the pack
+// is a fold or a pack expansion, so none of them recurses through the types
+
+template<typename... Ts>
+struct TypePack {};
+
+// Passes a type around as a value
+template<typename T>
+struct TypeTag {
+    typedef T type;
+};
+
+template<typename... As, typename... Bs>
+TypePack<As..., Bs...> operator+(TypePack<As...>, TypePack<Bs...>);
+
+// Concatenation of any number of packs
+template<typename... Packs>
+using concat_t = decltype((TypePack<>{} + ... + Packs{}));
+
+template<typename Pack>
+struct PackLength;
+
+template<typename... Ts>
+struct PackLength<TypePack<Ts...>> : std::integral_constant<std::size_t, sizeof...(Ts)> {};
+
+// ToPack - TypeList to TypePack
+template<typename TList>
+struct ToPack;
+
+template<>
+struct ToPack<NullType> {
+    typedef TypePack<> type;
+};
+
+template<typename T1, typename Tail>
+struct ToPack<TypeList<T1, Tail>> {
+    typedef concat_t<TypePack<T1>, typename ToPack<Tail>::type> type;
+};
+
+template<typename T1, typename T2, typename T3, typename T4, typename T5, typename T6,
+         typename T7, typename T8, typename Tail>
+struct ToPack<TypeList<T1, TypeList<T2, TypeList<T3, TypeList<T4, TypeList<T5,
+              TypeList<T6, TypeList<T7, TypeList<T8, Tail>>>>>>>>> {
+    typedef concat_t<TypePack<T1, T2, T3, T4, T5, T6, T7, T8>, typename ToPack<Tail>::type> type;
+};
+// ToPack
+
+// FromPack - TypePack to TypeList
+template<typename Pack>
+struct FromPack;
+
+template<>
+struct FromPack<TypePack<>> {
+    typedef NullType type;
+};
+
+template<typename T1, typename... Ts>
+struct FromPack<TypePack<T1, Ts...>> {
+    typedef TypeList<T1, typename FromPack<TypePack<Ts...>>::type> type;
+};
+
+template<typename T1, typename T2, typename T3, typename T4, typename T5, typename T6,
+         typename T7, typename T8, typename... Ts>
+struct FromPack<TypePack<T1, T2, T3, T4, T5, T6, T7, T8, Ts...>> {
+    typedef TypeList<T1, TypeList<T2, TypeList<T3, TypeList<T4, TypeList<T5, TypeList<T6,
+            TypeList<T7, TypeList<T8, typename FromPack<TypePack<Ts...>>::type>>>>>>>>
+        type;
+};
+// FromPack
+
+// PackTypeAt - every type is paired with its index as a distinct base,
+// so the type is picked by overload resolution
+template<std::size_t Idx, typename T>
+struct IndexedType {
+    typedef T type;
+};
+
+template<typename Indices, typename... Ts>
+struct IndexedTypes;
+
+template<std::size_t... Is, typename... Ts>
+struct IndexedTypes<std::index_sequence<Is...>, Ts...> : IndexedType<Is, Ts>... {};
+
+template<std::size_t Idx, typename T>
+IndexedType<Idx, T> SelectIndexed(const IndexedType<Idx, T>&);
+
+template<typename Pack, std::size_t Idx>
+struct PackTypeAt;
+
+template<typename... Ts, std::size_t Idx>
+struct PackTypeAt<TypePack<Ts...>, Idx> {
+    static_assert(Idx < sizeof...(Ts), "index out of range");
+
+    typedef typename decltype(SelectIndexed<Idx>(
+        std::declval<IndexedTypes<std::index_sequence_for<Ts...>, Ts...>>()))::type type;
+};
+// PackTypeAt
+
+// PackIndexOf - position of the first occurrence, -1 if there is none
+template<typename Pack, typename T>
+struct PackIndexOf;
+
+template<typename... Ts, typename T>
+struct PackIndexOf<TypePack<Ts...>, T> {
+    static constexpr int Find() {
+        constexpr bool kSame[] = {false, std::is_same_v<T, Ts>...};
+        for (std::size_t i = 1; i <= sizeof...(Ts); ++i) {
+            if (kSame[i]) {
+                return static_cast<int>(i) - 1;
+            }
+        }
+        return -1;
+    }
+
+    static constexpr int value = Find();
+};
+// PackIndexOf
+
+// PackEraseAt - drops the type at Pos; Pos = -1 keeps the pack as is
+template<typename Pack, int Pos, typename = std::make_index_sequence<PackLength<Pack>::value>>
+struct PackEraseAt;
+
+template<typename... Ts, int Pos, std::size_t... Is>
+struct PackEraseAt<TypePack<Ts...>, Pos, std::index_sequence<Is...>> {
+    typedef concat_t<
+        std::conditional_t<static_cast<int>(Is) == Pos, TypePack<>, TypePack<Ts>>...>
+        type;
+};
+// PackEraseAt
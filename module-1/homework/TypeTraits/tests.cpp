@@ -1,12 +1,18 @@
 #include <algorithm>
 #include <cmath>
 #include <iostream>
+#include <memory>
+#include <new>
+#include <stdexcept>
 #include <string>
+#include <utility>
 
 #include "gtest/gtest.h"
 #include "type_traits/is_copy_constructible.h"
 #include "type_traits/is_nothrow_move_constructible.h"
+#include "type_traits/is_trivially_relocatable.h"
 #include "type_traits/move_if_noexcept.h"
+#include "type_traits/relocate.h"
 
 TEST(IsConstructible, Test1) {
 
@@ -137,4 +143,100 @@ TEST(MoveIfNoExcept, Test2) {
     NonThrowFoo foo;
     NonThrowFoo foo2 = MoveIfNoExcept(foo);
     ASSERT_FALSE(foo2.copy);
-}
\ No newline at end of file
+}
+
+struct Relocatable {
+    explicit Relocatable(int v) : value(v) {
+    }
+    Relocatable(const Relocatable& other) : value(other.value) {
+        ++copies;
+    }
+    Relocatable(Relocatable&& other) noexcept : value(other.value) {
+        ++moves;
+    }
+    ~Relocatable() {
+    }
+
+    int value;
+    static inline int copies = 0;
+    static inline int moves = 0;
+};
+
+template <>
+struct IsTriviallyRelocatable<Relocatable> : std::true_type {};
+
+struct ThrowingCopy {
+    explicit ThrowingCopy(int v) : value(v) {
+    }
+    ThrowingCopy(const ThrowingCopy& other) : value(other.value) {
+        if (value == 2) {
+            throw std::runtime_error("copy");
+        }
+    }
+    ThrowingCopy(ThrowingCopy&&) noexcept(false) = default;
+
+    int value;
+};
+
+TEST(IsTriviallyRelocatable, Test1) {
+    static_assert(IsTriviallyRelocatable<int>::value);
+    static_assert(IsTriviallyRelocatable<std::unique_ptr<int>>::value);
+    static_assert(IsTriviallyRelocatable<std::pair<int, std::unique_ptr<int>>>::value);
+    static_assert(IsTriviallyRelocatable<Relocatable>::value);
+    static_assert(!IsTriviallyRelocatable<std::string>::value);
+    static_assert(!IsTriviallyRelocatable<std::pair<int, std::string>>::value);
+}
+
+template <typename T>
+T* Storage(std::size_t count) {
+    return static_cast<T*>(::operator new(count * sizeof(T)));
+}
+
+TEST(Relocate, Test1) {
+    Relocatable* from = Storage<Relocatable>(3);
+    Relocatable* to = Storage<Relocatable>(3);
+    for (int i = 0; i < 3; ++i) {
+        ::new (from + i) Relocatable(i);
+    }
+
+    ASSERT_EQ(Relocate(from, from + 3, to), to + 3);
+    ASSERT_EQ(to[2].value, 2);
+    ASSERT_EQ(Relocatable::copies + Relocatable::moves, 0);
+
+    for (int i = 0; i < 3; ++i) {
+        to[i].~Relocatable();
+    }
+    ::operator delete(from);
+    ::operator delete(to);
+}
+
+TEST(Relocate, Test2) {
+    std::string* from = Storage<std::string>(2);
+    std::string* to = Storage<std::string>(2);
+    ::new (from) std::string("a string too long for the small buffer");
+    ::new (from + 1) std::string("short");
+
+    static_assert(noexcept(Relocate(from, from + 2, to)));
+    Relocate(from, from + 2, to);
+    ASSERT_EQ(to[0], "a string too long for the small buffer");
+    ASSERT_EQ(to[1], "short");
+
+    to[0].~basic_string();
+    to[1].~basic_string();
+    ::operator delete(from);
+    ::operator delete(to);
+}
+
+TEST(Relocate, Test3) {
+    ThrowingCopy* from = Storage<ThrowingCopy>(3);
+    ThrowingCopy* to = Storage<ThrowingCopy>(3);
+    for (int i = 0; i < 3; ++i) {
+        ::new (from + i) ThrowingCopy(i);
+    }
+
+    ASSERT_THROW(Relocate(from, from + 3, to), std::runtime_error);
+    ASSERT_EQ(from[1].value, 1);
+
+    ::operator delete(from);
+    ::operator delete(to);
+}
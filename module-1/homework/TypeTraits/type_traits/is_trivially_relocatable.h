@@ -0,0 +1,20 @@
+#pragma once
+
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+// IsTriviallyRelocatable - moving an object into new storage and destroying the original
+// is the same as copying its bytes. Trivially copyable types are inferred, other types
+// opt in with a specialization deriving from std::true_type
+template <typename T>
+struct IsTriviallyRelocatable : std::is_trivially_copyable<T> {};
+
+// IsTriviallyRelocatable - opt-in specializations
+template <typename T>
+struct IsTriviallyRelocatable<std::unique_ptr<T>> : std::true_type {};
+
+template <typename First, typename Second>
+struct IsTriviallyRelocatable<std::pair<First, Second>>
+    : std::conjunction<IsTriviallyRelocatable<First>, IsTriviallyRelocatable<Second>> {};
+// IsTriviallyRelocatable - opt-in specializations
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "is_nothrow_move_constructible.h"
+#include "is_trivially_relocatable.h"
+#include "move_if_noexcept.h"
+
+// Relocate - moves [first, last) into the uninitialized, non-overlapping storage at dest
+// and destroys the originals. Trivially relocatable ranges are copied with one memcpy,
+// others element by element through MoveIfNoExcept; if that throws, the elements built
+// at dest are destroyed and the source range is left as it was.
+// Returns the end of the destination range
+template <typename T>
+T* Relocate(T* first, T* last, T* dest) noexcept(IsTriviallyRelocatable<T>::value ||
+                                                 IsNoThrowMoveConstructible<T>::value) {
+    if (first == last) {
+        return dest;
+    }
+
+    if constexpr (IsTriviallyRelocatable<T>::value) {
+        const std::ptrdiff_t count = last - first;
+        std::memcpy(static_cast<void*>(dest), static_cast<const void*>(first),
+                    static_cast<std::size_t>(count) * sizeof(T));
+        return dest + count;
+    } else {
+        T* current = dest;
+        if constexpr (IsNoThrowMoveConstructible<T>::value) {
+            for (T* it = first; it != last; ++it, ++current) {
+                ::new (static_cast<void*>(current)) T(std::move(*it));
+            }
+        } else {
+            try {
+                for (T* it = first; it != last; ++it, ++current) {
+                    ::new (static_cast<void*>(current)) T(MoveIfNoExcept(*it));
+                }
+            } catch (...) {
+                for (; current != dest; --current) {
+                    (current - 1)->~T();
+                }
+                throw;
+            }
+        }
+
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            for (; first != last; ++first) {
+                first->~T();
+            }
+        }
+        return current;
+    }
+}
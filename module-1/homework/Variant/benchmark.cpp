@@ -0,0 +1,135 @@
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <variant>
+#include <vector>
+
+#include "variant.h"
+
+// Double dispatch over pairs of messages: task::Visit looks the pair up in one table,
+// std::visit is the reference. Not part of the test run, which adds sanitizers; take
+// numbers from an optimized build, e.g.
+//   g++ -std=c++20 -O2 benchmark.cpp -o benchmark
+
+namespace {
+
+constexpr int32_t kPairs = 1'000'000;
+constexpr int32_t kPasses = 20;
+
+struct Ping {
+    int64_t id = 1;
+};
+
+struct Pong {
+    int64_t id = 2;
+};
+
+struct Data {
+    int64_t size = 3;
+};
+
+struct Close {
+    int32_t code = 4;
+};
+
+// Every pair of kinds gets its own arithmetic, so no two table entries fold into one
+struct Handler {
+    int64_t operator()(const Ping& a, const Ping& b) const {
+        return a.id + b.id;
+    }
+    int64_t operator()(const Ping& a, const Pong& b) const {
+        return a.id * b.id;
+    }
+    int64_t operator()(const Pong& a, const Ping& b) const {
+        return a.id - b.id;
+    }
+    int64_t operator()(const Data& a, const Data& b) const {
+        return a.size ^ b.size;
+    }
+    int64_t operator()(const Close& a, const Close& b) const {
+        return a.code + 2 * b.code;
+    }
+    template <typename A, typename B>
+    int64_t operator()(const A&, const B&) const {
+        return 7;
+    }
+};
+
+template <typename F>
+double Milliseconds(F&& f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+        .count();
+}
+
+template <typename V>
+void Fill(std::vector<V>& messages, const std::vector<int32_t>& kinds) {
+    for (int32_t kind : kinds) {
+        switch (kind) {
+            case 0:
+                messages.emplace_back(Ping{});
+                break;
+            case 1:
+                messages.emplace_back(Pong{});
+                break;
+            case 2:
+                messages.emplace_back(Data{});
+                break;
+            default:
+                messages.emplace_back(Close{});
+        }
+    }
+}
+
+template <typename V, typename VisitFn>
+double DoubleDispatch(const std::vector<V>& lhs, const std::vector<V>& rhs, VisitFn visit,
+                      int64_t* sum) {
+    return Milliseconds([&] {
+        for (int32_t pass = 0; pass < kPasses; ++pass) {
+            for (int32_t i = 0; i < kPairs; ++i) {
+                *sum += visit(Handler{}, lhs[i], rhs[i]);
+            }
+        }
+    });
+}
+
+}  // namespace
+
+int main() {
+    std::mt19937 random(42);
+    std::uniform_int_distribution<int32_t> kind(0, 3);
+    std::vector<int32_t> lhs_kinds(kPairs);
+    std::vector<int32_t> rhs_kinds(kPairs);
+    for (int32_t i = 0; i < kPairs; ++i) {
+        lhs_kinds[i] = kind(random);
+        rhs_kinds[i] = kind(random);
+    }
+
+    using Message = task::Variant<Ping, Pong, Data, Close>;
+    using StdMessage = std::variant<Ping, Pong, Data, Close>;
+    std::vector<Message> lhs;
+    std::vector<Message> rhs;
+    std::vector<StdMessage> std_lhs;
+    std::vector<StdMessage> std_rhs;
+    Fill(lhs, lhs_kinds);
+    Fill(rhs, rhs_kinds);
+    Fill(std_lhs, lhs_kinds);
+    Fill(std_rhs, rhs_kinds);
+
+    int64_t sum = 0;
+    int64_t std_sum = 0;
+    double ms = DoubleDispatch(
+        lhs, rhs, [](auto&& f, const auto& a, const auto& b) { return task::Visit(f, a, b); },
+        &sum);
+    double std_ms = DoubleDispatch(
+        std_lhs, std_rhs,
+        [](auto&& f, const auto& a, const auto& b) { return std::visit(f, a, b); }, &std_sum);
+
+    std::cout << "double dispatch over " << kPairs << " pairs x" << kPasses << " (ms)\n"
+              << "  task::Visit       " << ms << "\n"
+              << "  std::visit        " << std_ms << "\n"
+              << (sum == std_sum ? "" : "results differ\n");
+    return sum == std_sum ? 0 : 1;
+}
@@ -0,0 +1,50 @@
+#include <cstddef>
+#include <utility>
+
+#include "variant.h"
+
+// Compile-time benchmark: one Variant over VARIANT_ALTERNATIVES distinct types, each of
+// them assigned, checked, read back by index and by type, and copied. Storage access and
+// the FindExactlyOneT lookups are what gets instantiated per alternative, so build time
+// and object size follow their depth. The compile_benchmark_<count> targets build it for
+// 10, 50 and 200 alternatives; by hand, e.g.
+//   time g++ -std=c++20 -O2 -c -DVARIANT_ALTERNATIVES=200 compile_benchmark.cpp
+//   size compile_benchmark.o
+
+#ifndef VARIANT_ALTERNATIVES
+#define VARIANT_ALTERNATIVES 200
+#endif
+
+namespace {
+
+constexpr size_t kAlternatives = VARIANT_ALTERNATIVES;
+
+template <size_t I>
+struct Tag {
+    size_t value = I;
+};
+
+template <size_t... Is>
+task::Variant<Tag<Is>...> MakeVariant(std::index_sequence<Is...>);
+
+using Many = decltype(MakeVariant(std::make_index_sequence<kAlternatives>{}));
+
+// Returns the sum of every alternative read both ways, or 0 if one was not held
+template <size_t... Is>
+size_t TouchAll(Many& v, std::index_sequence<Is...>) {
+    size_t sum = 0;
+    size_t held = 0;
+    ((v = Tag<Is>{}, held += task::HoldsAlternative<Tag<Is>>(v),
+      sum += task::Get<Is>(v).value + task::Get<Tag<Is>>(v).value),
+     ...);
+    return held == sizeof...(Is) ? sum : 0;
+}
+
+}  // namespace
+
+int main() {
+    Many v;
+    size_t sum = TouchAll(v, std::make_index_sequence<kAlternatives>{});
+    Many copy(v);
+    return sum == kAlternatives * (kAlternatives - 1) && copy.Index() == kAlternatives - 1 ? 0 : 1;
+}
@@ -1,5 +1,8 @@
 #include <cmath>
+#include <cstring>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include "gtest/gtest.h"
 #include "variant.h"
@@ -28,6 +31,274 @@ TEST(Get, Test4) {
     ASSERT_NEAR(task::Get<1>(v), 12.0, 1e-5);
 }
 
+TEST(Index, Test1) {
+    task::Variant<int32_t, double, std::string> v;
+    ASSERT_EQ(v.Index(), 0u);
+    v = 12.0;
+    ASSERT_EQ(v.Index(), 1u);
+    v = "Hello world";
+    ASSERT_EQ(v.Index(), 2u);
+    ASSERT_TRUE(task::HoldsAlternative<std::string>(v));
+    ASSERT_THROW(task::Get<double>(v), task::BadVariantAccess);
+
+    static_assert(sizeof(task::Variant<char, int8_t>) == 2);
+}
+
+struct Counted {
+    explicit Counted(int* alive) : alive(alive) {
+        ++*alive;
+    }
+
+    Counted(const Counted& other) : alive(other.alive) {
+        ++*alive;
+    }
+
+    Counted& operator=(const Counted&) = default;
+
+    ~Counted() {
+        --*alive;
+    }
+
+    int* alive;
+};
+
+TEST(Index, Test2) {
+    int alive = 0;
+    {
+        task::Variant<int32_t, Counted, std::string> v;
+        v = Counted(&alive);
+        ASSERT_EQ(alive, 1);
+
+        task::Variant<int32_t, Counted, std::string> copy(v);
+        ASSERT_EQ(alive, 2);
+
+        copy = "Hello world";
+        ASSERT_EQ(alive, 1);
+        ASSERT_EQ(task::Get<std::string>(copy), "Hello world");
+
+        v = copy;
+        ASSERT_EQ(alive, 0);
+        ASSERT_EQ(task::Get<2>(v), "Hello world");
+
+        v = Counted(&alive);
+    }
+    ASSERT_EQ(alive, 0);
+}
+
+TEST(Visit, Test1) {
+    struct Visitor {
+        std::string operator()(int32_t value) const {
+            return "int " + std::to_string(value);
+        }
+
+        std::string operator()(double) const {
+            return "double";
+        }
+
+        std::string operator()(const std::string& value) const {
+            return value;
+        }
+    };
+
+    task::Variant<int32_t, double, std::string> v;
+    ASSERT_EQ(task::Visit(Visitor{}, v), "int 0");
+    v = 12.0;
+    ASSERT_EQ(task::Visit(Visitor{}, v), "double");
+    v = "Hello world";
+    ASSERT_EQ(task::Visit(Visitor{}, v), "Hello world");
+
+    task::Visit([](auto& value) { value += value; }, v);
+    ASSERT_EQ(task::Get<std::string>(v), "Hello worldHello world");
+}
+
+std::string Name(int32_t) {
+    return "int";
+}
+
+std::string Name(double) {
+    return "double";
+}
+
+std::string Name(const std::string&) {
+    return "string";
+}
+
+TEST(Visit, Test2) {
+    task::Variant<int32_t, double, std::string> v1;
+    task::Variant<std::string, int32_t> v2;
+    v1 = 12.0;
+    v2 = "Hello world";
+
+    auto describe = [](const auto& lhs, const auto& rhs) {
+        return Name(lhs) + " " + Name(rhs);
+    };
+    ASSERT_EQ(task::Visit(describe, v1, v2), "double string");
+
+    v2 = 5;
+    ASSERT_EQ(task::Visit(describe, v1, v2), "double int");
+
+    v1 = "Hello world";
+    ASSERT_EQ(task::Visit(describe, v1, v2), "string int");
+
+    task::Variant<int32_t, double> v3;
+    v3 = 2.5;
+    auto sum = [](const auto& a, const auto& b, const auto& c) {
+        return static_cast<double>(a) + static_cast<double>(b) + static_cast<double>(c);
+    };
+    task::Variant<int32_t, double> v4;
+    v4 = 4;
+    ASSERT_NEAR(task::Visit(sum, v3, v4, v3), 9.0, 1e-5);
+}
+
+TEST(Trivial, Test1) {
+    using Trivial = task::Variant<int32_t, double, char>;
+    static_assert(std::is_trivially_copyable_v<Trivial>);
+    static_assert(std::is_trivially_destructible_v<Trivial>);
+
+    using NonTrivial = task::Variant<int32_t, std::string>;
+    static_assert(!std::is_trivially_copyable_v<NonTrivial>);
+    static_assert(!std::is_trivially_destructible_v<NonTrivial>);
+    static_assert(std::is_nothrow_move_constructible_v<NonTrivial>);
+
+    Trivial v;
+    v = 12.0;
+    Trivial copy;
+    std::memcpy(static_cast<void*>(&copy), &v, sizeof(Trivial));
+    ASSERT_EQ(copy.Index(), 1u);
+    ASSERT_NEAR(task::Get<double>(copy), 12.0, 1e-5);
+
+    copy = 'a';
+    v = copy;
+    ASSERT_EQ(task::Get<char>(v), 'a');
+}
+
+TEST(Trivial, Test2) {
+    using MoveOnly = task::Variant<std::unique_ptr<int32_t>, int32_t>;
+    static_assert(!std::is_copy_constructible_v<MoveOnly>);
+    static_assert(!std::is_copy_assignable_v<MoveOnly>);
+    static_assert(std::is_nothrow_move_constructible_v<MoveOnly>);
+    static_assert(std::is_move_assignable_v<MoveOnly>);
+
+    struct NoAssign {
+        NoAssign& operator=(const NoAssign&) = delete;
+    };
+    using CopyOnly = task::Variant<int32_t, NoAssign>;
+    static_assert(std::is_copy_constructible_v<CopyOnly>);
+    static_assert(!std::is_copy_assignable_v<CopyOnly>);
+
+    MoveOnly v = std::make_unique<int32_t>(5);
+    MoveOnly moved(std::move(v));
+    ASSERT_EQ(*task::Get<0>(moved), 5);
+}
+
+struct Payload {
+    Payload(int* moves, std::string text) : moves(moves), text(std::move(text)) {
+    }
+
+    Payload(Payload&& other) noexcept : moves(other.moves), text(std::move(other.text)) {
+        ++*moves;
+    }
+
+    int* moves;
+    std::string text;
+};
+
+TEST(Emplace, Test1) {
+    int moves = 0;
+    task::Variant<int32_t, Payload> v;
+    Payload& payload = v.Emplace<Payload>(&moves, "Hello world");
+    ASSERT_EQ(v.Index(), 1u);
+    ASSERT_EQ(payload.text, "Hello world");
+
+    v.Emplace<1>(&moves, "Bye");
+    ASSERT_EQ(task::Get<Payload>(v).text, "Bye");
+
+    ASSERT_EQ(v.Emplace<0>(5), 5);
+    ASSERT_EQ(v.Index(), 0u);
+    ASSERT_EQ(moves, 0);
+}
+
+TEST(Emplace, Test2) {
+    task::Variant<int32_t, double, std::string> v = "Hello world";
+    ASSERT_EQ(task::Get<std::string>(v), "Hello world");
+
+    task::Variant<int32_t, double, std::string> d = 12.0;
+    ASSERT_EQ(d.Index(), 1u);
+
+    int moves = 0;
+    task::Variant<int32_t, Payload> p(std::in_place_type<Payload>, &moves, "Hello world");
+    ASSERT_EQ(task::Get<1>(p).text, "Hello world");
+
+    task::Variant<int32_t, Payload> i(std::in_place_index<0>, 7);
+    ASSERT_EQ(task::Get<int32_t>(i), 7);
+    ASSERT_EQ(moves, 0);
+}
+
+template <typename V, typename T>
+constexpr bool kCanEmplace = requires(V v) { v.template Emplace<T>(5); };
+
+TEST(Emplace, Test3) {
+    // Types are named exactly: int32_t would convert to either alternative
+    using V = task::Variant<int64_t, double>;
+    static_assert(std::is_constructible_v<V, std::in_place_type_t<double>, int32_t>);
+    static_assert(!std::is_constructible_v<V, std::in_place_type_t<int32_t>, int32_t>);
+    static_assert(!std::is_constructible_v<task::Variant<int32_t, int32_t>,
+                                           std::in_place_type_t<int32_t>, int32_t>);
+    static_assert(kCanEmplace<V, int64_t> && !kCanEmplace<V, int32_t>);
+    static_assert(!std::is_constructible_v<V, std::vector<int32_t>>);
+    static_assert(!std::is_assignable_v<V&, std::vector<int32_t>>);
+    static_assert(!std::is_constructible_v<task::Variant<int32_t, int32_t>, int32_t>);
+    static_assert(std::is_constructible_v<V, int32_t> && std::is_assignable_v<V&, int32_t>);
+
+    V v(std::in_place_type<double>, 5);
+    ASSERT_EQ(v.Index(), 1u);
+    ASSERT_EQ(v.Emplace<int64_t>(7), 7);
+    ASSERT_EQ(v.Index(), 0u);
+}
+
+template <size_t N>
+struct Tag {
+    size_t value = N;
+};
+
+template <size_t... Is>
+task::Variant<Tag<Is>...> MakeManyAlternatives(std::index_sequence<Is...>);
+
+TEST(Storage, Test1) {
+    static_assert(sizeof(task::Variant<char, int32_t>) == 2 * sizeof(int32_t));
+    static_assert(sizeof(task::Variant<char, std::string>) ==
+                  sizeof(std::string) + alignof(std::string));
+    static_assert(alignof(task::Variant<char, double>) == alignof(double));
+
+    using Many = decltype(MakeManyAlternatives(std::make_index_sequence<200>{}));
+    static_assert(sizeof(Many) == 2 * sizeof(size_t));
+
+    Many v;
+    v = Tag<199>{};
+    ASSERT_EQ(v.Index(), 199u);
+    ASSERT_EQ(task::Get<199>(v).value, 199u);
+    ASSERT_EQ(task::Visit([](const auto& tag) { return tag.value; }, v), 199u);
+}
+
+TEST(FindExactlyOne, Test1) {
+    static_assert(task::FindExactlyOneT<double, int32_t, double, std::string>::kValue == 1);
+    static_assert(task::FindExactlyOneT<const char*, int32_t, double, std::string>::kValue == 2);
+    static_assert(task::FindExactlyOneT<int32_t, double, int32_t>::kValue == 1);
+    static_assert(task::kExactIndex<int32_t, int64_t, double> == task::kNotFound);
+    static_assert(task::kExactIndex<int32_t, int32_t, double, int32_t> == task::kNotFound);
+
+    using Many = decltype(MakeManyAlternatives(std::make_index_sequence<200>{}));
+    Many v = Tag<150>{};
+    ASSERT_TRUE(task::HoldsAlternative<Tag<150>>(v));
+    ASSERT_EQ(task::Get<Tag<150>>(v).value, 150u);
+}
+
+TEST(FindExactlyOne, Test2) {
+    task::Variant<int64_t, double> v = 1.5;
+    ASSERT_TRUE(task::HoldsAlternative<double>(v));
+    ASSERT_FALSE(task::HoldsAlternative<int64_t>(v));
+}
+
 int main(int argc, char** argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
@@ -1,4 +1,11 @@
+#include <algorithm>
+#include <array>
+#include <cstdint>
 #include <cstdlib>
+#include <exception>
+#include <limits>
+#include <new>
+#include <type_traits>
 #include <utility>
 
 #pragma once
@@ -6,73 +13,62 @@
 namespace task {
 
 template <typename... Types>
-class Variant;
-
-// -------Union-------
-template <size_t Idx, typename... Tail>
-union StoreUnion;
+class VariantBase;
 
-template <size_t Idx>
-union StoreUnion<Idx> {};
+template <typename... Types>
+class Variant;
 
-template <size_t Idx, typename Head, typename... Tail>
-union StoreUnion<Idx, Head, Tail...> {
+class BadVariantAccess : public std::exception {
 public:
-    Head head;
-
-    StoreUnion<Idx + 1, Tail...> tail;
-
-    StoreUnion() : tail() {
-        if (!std::is_trivially_constructible_v<Head>) {
-            new (&head) Head();
-        }
-    }
-
-    ~StoreUnion() {
-        if (!std::is_trivially_destructible_v<Head>) {
-            head.~Head();
-        }
+    const char* what() const noexcept override {
+        return "bad variant access";
     }
 };
-// -------Union-------
 
-struct UnionHelper {
-    template <typename U>
-    static constexpr auto&& Get(U&& v, std::in_place_index_t<0>) {
-        return std::forward<U>(v).head;
-    }
-
-    template <typename U, size_t Idx>
-    static constexpr auto&& Get(U&& v, std::in_place_index_t<Idx>) {
-        return Get(std::forward<U>(v).tail, std::in_place_index<Idx - 1>);
+// -------Storage-------
+// Raw bytes fitting the largest alternative. Nothing is constructed or destroyed here:
+// Variant knows the live alternative and manages its lifetime
+template <typename... Types>
+struct VariantStorage {
+    void* Raw() noexcept {
+        return data;
     }
 
-    template <std::size_t Idx, typename U, std::size_t UnIdx, typename Head, typename... Tail>
-    static void Set(U&& value, std::in_place_index_t<0>, StoreUnion<UnIdx, Head, Tail...>& u) {
-        u.head = value;
+    const void* Raw() const noexcept {
+        return data;
     }
 
-    template <std::size_t Idx, typename U, std::size_t UnIdx, typename Head, typename... Tail>
-    static void Set(U&& value, std::in_place_index_t<Idx>, StoreUnion<UnIdx, Head, Tail...>& u) {
-        UnionHelper::Set<Idx - 1>(std::forward<U>(value), std::in_place_index<Idx - 1>, u.tail);
-    }
+    alignas(Types...) unsigned char data[std::max({sizeof(Types)...})];
 };
+// -------Storage-------
 
 // -------TypeList-------
 template <typename...>
 struct TypeList {};
 
+// Every type is paired with its index as a distinct base, so TypeAt is picked
+// by overload resolution instead of peeling the list one type at a time
+template <size_t Idx, typename T>
+struct IndexedType {
+    using type = T;
+};
+
+template <typename Indices, typename... Types>
+struct IndexedTypes;
+
+template <size_t... Is, typename... Types>
+struct IndexedTypes<std::index_sequence<Is...>, Types...> : IndexedType<Is, Types>... {};
+
+template <size_t Idx, typename T>
+IndexedType<Idx, T> SelectIndexed(const IndexedType<Idx, T>&);
+
 template <size_t Idx, typename TList>
 struct TypeAt {};
 
-template <typename Head, typename... Tail>
-struct TypeAt<0, TypeList<Head, Tail...>> {
-    typedef Head target_type;
-};
-
-template <size_t Idx, typename Head, typename... Tail>
-struct TypeAt<Idx, TypeList<Head, Tail...>> {
-    typedef typename TypeAt<Idx - 1, TypeList<Tail...>>::target_type target_type;
+template <size_t Idx, typename... Types>
+struct TypeAt<Idx, TypeList<Types...>> {
+    using target_type = typename decltype(SelectIndexed<Idx>(
+        std::declval<IndexedTypes<std::index_sequence_for<Types...>, Types...>>()))::type;
 };
 
 template <size_t Idx, typename T>
@@ -85,67 +81,81 @@ template <size_t Idx, typename... Types>
 struct VariantAlternative<Idx, Variant<Types...>> {
     using type = typename TypeAt<Idx, TypeList<Types...>>::target_type;
 };
-// -------TypeList-------
+
+template <size_t Idx, typename... Types>
+struct VariantAlternative<Idx, VariantBase<Types...>> {
+    using type = typename TypeAt<Idx, TypeList<Types...>>::target_type;
+};
+
+template <typename T>
+struct VariantSize;
 
 template <typename... Types>
-class Variant {
-public:
-    // Special member functions
-    constexpr Variant() noexcept {};
+struct VariantSize<Variant<Types...>> : std::integral_constant<size_t, sizeof...(Types)> {};
 
-    template <typename T>
-    Variant& operator=(T&& t) noexcept;
+template <typename... Types>
+struct VariantSize<VariantBase<Types...>> : std::integral_constant<size_t, sizeof...(Types)> {};
 
-    template <typename T, typename... OtherTypes>
-    friend auto&& GenericGet(Variant<OtherTypes...>& v);
+template <typename T>
+constexpr size_t variant_size_v = VariantSize<std::remove_cvref_t<T>>::value;
+// -------TypeList-------
 
-private:
-    StoreUnion<0, Types...> data_;
-};
+// -------Index-------
+constexpr size_t kVariantNpos = -1;
+
+// Smallest unsigned type holding every alternative index plus one value for kVariantNpos
+template <size_t Count>
+using variant_index_t = std::conditional_t<
+    (Count < std::numeric_limits<uint8_t>::max()), uint8_t,
+    std::conditional_t<(Count < std::numeric_limits<uint16_t>::max()), uint16_t, uint32_t>>;
+// -------Index-------
 
 // -------FindExactlyOneT-------
 const static size_t kNotFound = -1;
 const static size_t kAmbiguity = kNotFound - 1;
 
-template <size_t SizeofFound>
-constexpr size_t CheckDuplicatesHelper(size_t cur_pos, size_t res, const bool (&exact)[SizeofFound],
-                                       const bool (&convertible)[SizeofFound]) {
-    if (res == kAmbiguity) {
-        return kAmbiguity;
-    }
-
-    if (exact[cur_pos]) {
-        if (res == kNotFound || !exact[res]) {
-            return cur_pos;
-        }
+// The exact match is deduced from the index-tagged bases of IndexedTypes (see TypeAt),
+// which the whole list instantiates once; deduction fails unless the type occurs
+// exactly once. The remaining checks are folds over the pack, so no lookup
+// recurses through the list. A unique exact match wins; otherwise the last
+// convertible type is chosen
+template <typename T, size_t Idx>
+std::integral_constant<size_t, Idx> SelectExact(const IndexedType<Idx, T>&);
 
-        return kAmbiguity;
-    }
-
-    if (convertible[cur_pos] && res == kNotFound) {
-        return cur_pos;
-    }
+template <typename T>
+std::integral_constant<size_t, kNotFound> SelectExact(...);
 
-    return res;
-}
+// Index of TargetType if it occurs exactly once in Types, kNotFound otherwise
+template <typename TargetType, typename... Types>
+constexpr size_t kExactIndex = decltype(SelectExact<TargetType>(
+    std::declval<const IndexedTypes<std::index_sequence_for<Types...>, Types...>&>()))::value;
 
-template <size_t SizeofFound>
-constexpr size_t CheckDuplicates(size_t cur_pos, const bool (&exact)[SizeofFound],
-                                 const bool (&convertible)[SizeofFound]) {
-    if (cur_pos == SizeofFound) {
-        return kNotFound;
+// The lookup itself, without diagnostics, so that the converting members can be
+// constrained on it
+template <typename TargetType, typename... Types>
+struct FindConverting {
+    static constexpr size_t kExact = kExactIndex<TargetType, Types...>;
+
+    template <size_t... Is>
+    static constexpr size_t Find(std::index_sequence<Is...>) {
+        if constexpr (kExact != kNotFound) {
+            return kExact;
+        } else if constexpr ((std::is_same_v<TargetType, Types> || ...)) {
+            return kAmbiguity;
+        } else {
+            // Conversions are only checked when there is no exact match
+            size_t convertible = kNotFound;
+            ((convertible = std::is_convertible_v<TargetType, Types> ? Is : convertible), ...);
+            return convertible;
+        }
     }
 
-    return CheckDuplicatesHelper(cur_pos, CheckDuplicates(cur_pos + 1, exact, convertible), exact,
-                                 convertible);
-}
+    constexpr static size_t kValue = Find(std::index_sequence_for<Types...>{});
+};
 
 template <typename TargetType, typename... Types>
-struct FindExactlyOneChecked {
-    constexpr static bool kExact[sizeof...(Types)] = {std::is_same<TargetType, Types>::value...};
-    constexpr static bool kConvertible[sizeof...(Types)] = {
-        std::is_convertible<TargetType, Types>::value...};
-    constexpr static size_t kValue = CheckDuplicates(0, kExact, kConvertible);
+struct FindExactlyOneChecked : FindConverting<TargetType, Types...> {
+    static constexpr size_t kValue = FindConverting<TargetType, Types...>::kValue;
 
     static_assert(kValue != kNotFound, "no such type in parameter list");
     static_assert(kValue != kAmbiguity,
@@ -159,42 +169,465 @@ struct FindExactlyOneChecked<T> {
 
 template <typename TargetType, typename... Types>
 struct FindExactlyOneT : public FindExactlyOneChecked<TargetType, Types...> {};
+
+// Members naming an alternative by type never fall back to a convertible one
+template <typename TargetType, typename... Types>
+struct FindExactT {
+    static constexpr size_t kValue = kExactIndex<TargetType, Types...>;
+
+    static_assert(kValue != kNotFound, "type must occur exactly once in parameter list");
+};
 // -------FindExactlyOneT-------
 
+// -------Base-------
+// Storage, index and the lifetime operations shared by all layers below
+template <typename... Types>
+class VariantBase {
+public:
+    constexpr size_t Index() const noexcept;
+
+    constexpr bool ValuelessByException() const noexcept;
+
+    friend struct VariantAccess;
+
+protected:
+    using index_type = variant_index_t<sizeof...(Types)>;
+
+    static constexpr index_type kNpos = std::numeric_limits<index_type>::max();
+
+    static constexpr bool kNothrowMoveConstructible =
+        (std::is_nothrow_move_constructible_v<Types> && ...);
+
+    static constexpr bool kNothrowMoveAssignable =
+        kNothrowMoveConstructible && (std::is_nothrow_move_assignable_v<Types> && ...);
+
+    // Expects no live alternative; if the constructor throws the variant stays valueless
+    template <size_t Idx, typename... Args>
+    void Construct(Args&&... args);
+
+    void Destroy() noexcept;
+
+    template <typename V>
+    void ConstructFrom(V&& other);
+
+    template <typename V>
+    void AssignFrom(V&& other);
+
+    VariantStorage<Types...> data_;
+    index_type index_ = kNpos;
+};
+
+// Trivially destructible alternatives leave the destructor implicit and trivial
+template <bool TriviallyDestructible, typename... Types>
+class VariantDestructBase : public VariantBase<Types...> {};
+
+template <typename... Types>
+class VariantDestructBase<false, Types...> : public VariantBase<Types...> {
+public:
+    VariantDestructBase() = default;
+    VariantDestructBase(const VariantDestructBase&) = default;
+    VariantDestructBase(VariantDestructBase&&) = default;
+    VariantDestructBase& operator=(const VariantDestructBase&) = default;
+    VariantDestructBase& operator=(VariantDestructBase&&) = default;
+
+    ~VariantDestructBase() {
+        this->Destroy();
+    }
+};
+
 template <typename... Types>
+using variant_destruct_base_t =
+    VariantDestructBase<(std::is_trivially_destructible_v<Types> && ...), Types...>;
+
+// Trivially copyable alternatives are copied bytewise together with the index,
+// which keeps Variant itself trivially copyable
+template <bool TriviallyCopyable, typename... Types>
+class VariantCopyBase : public variant_destruct_base_t<Types...> {};
+
+template <typename... Types>
+class VariantCopyBase<false, Types...> : public variant_destruct_base_t<Types...> {
+public:
+    VariantCopyBase() = default;
+
+    VariantCopyBase(const VariantCopyBase& other) {
+        this->ConstructFrom(other);
+    }
+
+    VariantCopyBase(VariantCopyBase&& other) noexcept(VariantCopyBase::kNothrowMoveConstructible) {
+        this->ConstructFrom(std::move(other));
+    }
+
+    VariantCopyBase& operator=(const VariantCopyBase& other) {
+        this->AssignFrom(other);
+        return *this;
+    }
+
+    VariantCopyBase& operator=(VariantCopyBase&& other) noexcept(
+        VariantCopyBase::kNothrowMoveAssignable) {
+        this->AssignFrom(std::move(other));
+        return *this;
+    }
+
+    ~VariantCopyBase() = default;
+};
+
+template <typename... Types>
+using variant_copy_base_t =
+    VariantCopyBase<(std::is_trivially_copyable_v<Types> && ...), Types...>;
+
+// An alternative that cannot be copied deletes the copy operations of Variant,
+// so std::is_copy_constructible and std::is_copy_assignable report the truth
+template <bool CopyConstructible, bool CopyAssignable, typename... Types>
+class VariantCopyableBase : public variant_copy_base_t<Types...> {};
+
+template <typename... Types>
+class VariantCopyableBase<true, false, Types...> : public variant_copy_base_t<Types...> {
+public:
+    VariantCopyableBase() = default;
+    VariantCopyableBase(const VariantCopyableBase&) = default;
+    VariantCopyableBase(VariantCopyableBase&&) = default;
+    VariantCopyableBase& operator=(const VariantCopyableBase&) = delete;
+    VariantCopyableBase& operator=(VariantCopyableBase&&) = default;
+};
+
+template <typename... Types>
+class VariantCopyableBase<false, false, Types...> : public variant_copy_base_t<Types...> {
+public:
+    VariantCopyableBase() = default;
+    VariantCopyableBase(const VariantCopyableBase&) = delete;
+    VariantCopyableBase(VariantCopyableBase&&) = default;
+    VariantCopyableBase& operator=(const VariantCopyableBase&) = delete;
+    VariantCopyableBase& operator=(VariantCopyableBase&&) = default;
+};
+
+template <typename... Types>
+using variant_copyable_base_t =
+    VariantCopyableBase<(std::is_copy_constructible_v<Types> && ...),
+                        (std::is_copy_constructible_v<Types> && ...) &&
+                            (std::is_copy_assignable_v<Types> && ...),
+                        Types...>;
+// -------Base-------
+
+template <typename T>
+struct IsInPlaceTag : std::false_type {};
+
 template <typename T>
-Variant<Types...>& Variant<Types...>::operator=(T&& t) noexcept {
-    constexpr size_t kIdx = FindExactlyOneT<T, Types...>::kValue;
-    UnionHelper::Set<kIdx>(std::forward<T>(t), std::in_place_index<kIdx>, data_);
+struct IsInPlaceTag<std::in_place_type_t<T>> : std::true_type {};
+
+template <size_t Idx>
+struct IsInPlaceTag<std::in_place_index_t<Idx>> : std::true_type {};
+
+template <typename T, typename... Types>
+struct IsConvertingTarget
+    : std::bool_constant<(FindConverting<T, Types...>::kValue < kAmbiguity)> {};
+
+// Excludes the copy/move overloads and in-place tags from the converting members, and
+// types that pick no alternative or an ambiguous one; the lookup runs last, only for
+// types that passed the cheaper checks
+template <typename T, typename V, typename... Types>
+using enable_if_converting_t = std::enable_if_t<
+    std::conjunction_v<std::negation<std::is_same<std::remove_cvref_t<T>, V>>,
+                       std::negation<IsInPlaceTag<std::remove_cvref_t<T>>>,
+                       IsConvertingTarget<std::remove_cvref_t<T>, Types...>>>;
+
+// The in_place_type constructor and Emplace<T> take only a type that occurs exactly once
+template <typename T, typename... Types>
+using enable_if_exactly_one_t = std::enable_if_t<kExactIndex<T, Types...> != kNotFound>;
+
+template <typename... Types>
+class Variant : public variant_copyable_base_t<Types...> {
+public:
+    // Special member functions
+    Variant() noexcept(std::is_nothrow_default_constructible_v<variant_alternative_t<0, Variant>>);
+
+    // Constructs the alternative chosen by FindExactlyOneT directly from t
+    template <typename T, typename = enable_if_converting_t<T, Variant, Types...>>
+    Variant(T&& t);  // NOLINT
+
+    template <size_t Idx, typename... Args>
+    explicit Variant(std::in_place_index_t<Idx>, Args&&... args);
+
+    template <typename T, typename... Args, typename = enable_if_exactly_one_t<T, Types...>>
+    explicit Variant(std::in_place_type_t<T>, Args&&... args);
+
+    template <typename T, typename = enable_if_converting_t<T, Variant, Types...>>
+    Variant& operator=(T&& t);
+
+    // Destroys the current alternative and constructs the new one in its place
+    template <size_t Idx, typename... Args>
+    variant_alternative_t<Idx, Variant>& Emplace(Args&&... args);
+
+    template <typename T, typename... Args, typename = enable_if_exactly_one_t<T, Types...>>
+    T& Emplace(Args&&... args);
+
+private:
+    template <typename T>
+    static constexpr size_t kConvertingIndex =
+        FindExactlyOneT<std::remove_cvref_t<T>, Types...>::kValue;
+};
+
+// -------Visit-------
+struct VariantAccess {
+    template <typename V>
+    static constexpr auto&& Data(V&& v) noexcept {
+        return std::forward<V>(v).data_;
+    }
+};
+
+// Unchecked access to the alternative Idx, keeping the value category of v
+template <size_t Idx, typename V>
+auto&& GetAlternative(V&& v) noexcept {
+    using alternative_type = variant_alternative_t<Idx, std::remove_cvref_t<V>>;
+    using pointer = std::conditional_t<std::is_const_v<std::remove_reference_t<V>>,
+                                       const alternative_type*, alternative_type*>;
+
+    auto* alternative = std::launder(static_cast<pointer>(VariantAccess::Data(v).Raw()));
+    if constexpr (std::is_lvalue_reference_v<V>) {
+        return *alternative;
+    } else {
+        return std::move(*alternative);
+    }
+}
+
+// One entry per alternative: dispatch is a single indexed indirect call
+template <typename Visitor, typename V, typename = std::make_index_sequence<variant_size_v<V>>>
+struct VisitTable;
+
+template <typename Visitor, typename V, size_t... Is>
+struct VisitTable<Visitor, V, std::index_sequence<Is...>> {
+    using result_type = decltype(std::declval<Visitor>()(std::integral_constant<size_t, 0>{},
+                                                         GetAlternative<0>(std::declval<V>())));
+    using function_type = result_type (*)(Visitor&&, V&&);
+
+    template <size_t Idx>
+    static constexpr result_type Dispatch(Visitor&& vis, V&& v) {
+        return std::forward<Visitor>(vis)(std::integral_constant<size_t, Idx>{},
+                                          GetAlternative<Idx>(std::forward<V>(v)));
+    }
+
+    static constexpr function_type kTable[] = {&Dispatch<Is>...};
+};
+
+// Calls vis(integral_constant<size_t, Index>, alternative); v must not be valueless
+template <typename Visitor, typename V>
+constexpr decltype(auto) VisitIndexed(Visitor&& vis, V&& v) {
+    return VisitTable<Visitor&&, V&&>::kTable[v.Index()](std::forward<Visitor>(vis),
+                                                       std::forward<V>(v));
+}
+
+// Dispatch matrix for Visit(vis, vs...): one entry per combination of alternatives,
+// stored row-major so that any number of variants costs a single table lookup
+template <typename Visitor, typename... Vs>
+struct MultiVisitTable {
+    using result_type = decltype(std::declval<Visitor>()(GetAlternative<0>(std::declval<Vs>())...));
+    using function_type = result_type (*)(Visitor&&, Vs&&...);
+
+    static constexpr size_t kSizes[] = {variant_size_v<Vs>...};
+    static constexpr size_t kCount = (variant_size_v<Vs> * ...);
+
+    // Distance between entries that differ by one in the index of the k-th variant
+    static constexpr size_t Stride(size_t k) {
+        size_t stride = 1;
+        for (size_t i = k + 1; i < sizeof...(Vs); ++i) {
+            stride *= kSizes[i];
+        }
+        return stride;
+    }
+
+    template <size_t Flat, size_t... Ks>
+    static constexpr result_type Dispatch(Visitor&& vis, Vs&&... vs) {
+        return std::forward<Visitor>(vis)(
+            GetAlternative<Flat / Stride(Ks) % kSizes[Ks]>(std::forward<Vs>(vs))...);
+    }
+
+    template <size_t... Flat, size_t... Ks>
+    static constexpr auto MakeTable(std::index_sequence<Flat...>, std::index_sequence<Ks...>) {
+        return std::array<function_type, kCount>{&Dispatch<Flat, Ks...>...};
+    }
+
+    static constexpr std::array<function_type, kCount> kTable =
+        MakeTable(std::make_index_sequence<kCount>{}, std::index_sequence_for<Vs...>{});
+
+    static constexpr size_t FlatIndex(const Vs&... vs) {
+        size_t flat = 0;
+        ((flat = flat * variant_size_v<Vs> + vs.Index()), ...);
+        return flat;
+    }
+};
+
+template <typename Visitor, typename... Vs>
+constexpr decltype(auto) Visit(Visitor&& vis, Vs&&... vs) {
+    if ((vs.ValuelessByException() || ...)) {
+        throw BadVariantAccess();
+    }
+
+    using table = MultiVisitTable<Visitor&&, Vs&&...>;
+    return table::kTable[table::FlatIndex(vs...)](std::forward<Visitor>(vis),
+                                                  std::forward<Vs>(vs)...);
+}
+// -------Visit-------
+
+// VariantBase
+template <typename... Types>
+constexpr size_t VariantBase<Types...>::Index() const noexcept {
+    return index_ == kNpos ? kVariantNpos : index_;
+}
+
+template <typename... Types>
+constexpr bool VariantBase<Types...>::ValuelessByException() const noexcept {
+    return index_ == kNpos;
+}
+
+template <typename... Types>
+template <size_t Idx, typename... Args>
+void VariantBase<Types...>::Construct(Args&&... args) {
+    using alternative_type = variant_alternative_t<Idx, VariantBase>;
+    ::new (data_.Raw()) alternative_type(std::forward<Args>(args)...);
+    index_ = static_cast<index_type>(Idx);
+}
+
+template <typename... Types>
+void VariantBase<Types...>::Destroy() noexcept {
+    if constexpr (!(std::is_trivially_destructible_v<Types> && ...)) {
+        if (!ValuelessByException()) {
+            VisitIndexed(
+                [](auto, auto& alt) {
+                    using alternative_type = std::remove_reference_t<decltype(alt)>;
+                    alt.~alternative_type();
+                },
+                *this);
+        }
+    }
+    index_ = kNpos;
+}
+
+// Copies or moves the alternative of other depending on its value category
+template <typename... Types>
+template <typename V>
+void VariantBase<Types...>::ConstructFrom(V&& other) {
+    if (!other.ValuelessByException()) {
+        VisitIndexed(
+            [this](auto idx, auto&& alt) { Construct<idx>(std::forward<decltype(alt)>(alt)); },
+            static_cast<std::conditional_t<std::is_lvalue_reference_v<V>, const VariantBase&,
+                                           VariantBase&&>>(other));
+    }
+}
+
+template <typename... Types>
+template <typename V>
+void VariantBase<Types...>::AssignFrom(V&& other) {
+    if (other.ValuelessByException()) {
+        Destroy();
+    } else if (index_ == other.index_) {
+        VisitIndexed(
+            [this](auto idx, auto&& alt) {
+                GetAlternative<idx>(*this) = std::forward<decltype(alt)>(alt);
+            },
+            static_cast<std::conditional_t<std::is_lvalue_reference_v<V>, const VariantBase&,
+                                           VariantBase&&>>(other));
+    } else {
+        Destroy();
+        ConstructFrom(std::forward<V>(other));
+    }
+}
+// VariantBase
+
+// Variant
+template <typename... Types>
+Variant<Types...>::Variant() noexcept(
+    std::is_nothrow_default_constructible_v<variant_alternative_t<0, Variant>>) {
+    this->template Construct<0>();
+}
+
+template <typename... Types>
+template <typename T, typename>
+Variant<Types...>::Variant(T&& t) {
+    this->template Construct<kConvertingIndex<T>>(std::forward<T>(t));
+}
+
+template <typename... Types>
+template <size_t Idx, typename... Args>
+Variant<Types...>::Variant(std::in_place_index_t<Idx>, Args&&... args) {
+    this->template Construct<Idx>(std::forward<Args>(args)...);
+}
+
+template <typename... Types>
+template <typename T, typename... Args, typename>
+Variant<Types...>::Variant(std::in_place_type_t<T>, Args&&... args) {
+    this->template Construct<kExactIndex<T, Types...>>(std::forward<Args>(args)...);
+}
+
+template <typename... Types>
+template <typename T, typename>
+Variant<Types...>& Variant<Types...>::operator=(T&& t) {
+    constexpr size_t kIdx = kConvertingIndex<T>;
+    if (this->index_ == kIdx) {
+        GetAlternative<kIdx>(*this) = std::forward<T>(t);
+    } else {
+        Emplace<kIdx>(std::forward<T>(t));
+    }
 
     return *this;
 }
 
+template <typename... Types>
+template <size_t Idx, typename... Args>
+variant_alternative_t<Idx, Variant<Types...>>& Variant<Types...>::Emplace(Args&&... args) {
+    this->Destroy();
+    this->template Construct<Idx>(std::forward<Args>(args)...);
+    return GetAlternative<Idx>(*this);
+}
+
+template <typename... Types>
+template <typename T, typename... Args, typename>
+T& Variant<Types...>::Emplace(Args&&... args) {
+    return Emplace<kExactIndex<T, Types...>>(std::forward<Args>(args)...);
+}
+// Variant
+
 // Non-member functions
 template <typename T, typename... Types>
-auto&& GenericGet(Variant<Types...>& v) {
-    return UnionHelper::Get(std::forward<Variant<Types...>>(v).data_,
-                            std::in_place_index<FindExactlyOneT<T, Types...>::kValue>);
+constexpr bool HoldsAlternative(const Variant<Types...>& v) noexcept {
+    return v.Index() == FindExactT<T, Types...>::kValue;
 }
 
 template <size_t I, typename... Types>
-constexpr const variant_alternative_t<I, Variant<Types...>>& Get(Variant<Types...>& v) {
-    return GenericGet<typename TypeAt<I, TypeList<Types...>>::target_type>(v);
+constexpr variant_alternative_t<I, Variant<Types...>>& Get(Variant<Types...>& v) {
+    if (v.Index() != I) {
+        throw BadVariantAccess();
+    }
+    return GetAlternative<I>(v);
+}
+
+template <size_t I, typename... Types>
+constexpr const variant_alternative_t<I, Variant<Types...>>& Get(const Variant<Types...>& v) {
+    if (v.Index() != I) {
+        throw BadVariantAccess();
+    }
+    return GetAlternative<I>(v);
 }
 
 template <size_t I, typename... Types>
 constexpr variant_alternative_t<I, Variant<Types...>>&& Get(Variant<Types...>&& v) {
-    return GenericGet<typename TypeAt<I, TypeList<Types...>>::target_type>(std::move(v));
+    if (v.Index() != I) {
+        throw BadVariantAccess();
+    }
+    return GetAlternative<I>(std::move(v));
+}
+
+template <typename T, typename... Types>
+constexpr T& Get(Variant<Types...>& v) {
+    return Get<FindExactT<T, Types...>::kValue>(v);
 }
 
 template <typename T, typename... Types>
-constexpr const T& Get(Variant<Types...>& v) {
-    return GenericGet<T>(v);
+constexpr const T& Get(const Variant<Types...>& v) {
+    return Get<FindExactT<T, Types...>::kValue>(v);
 }
 
 template <typename T, typename... Types>
 constexpr T&& Get(Variant<Types...>&& v) {
-    return GenericGet<T>(std::move(v));
+    return Get<FindExactT<T, Types...>::kValue>(std::move(v));
 }
 
-}  // namespace task
\ No newline at end of file
+}  // namespace task